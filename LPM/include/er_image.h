@@ -16,6 +16,8 @@
 #ifndef EYEDEA_ER_IMAGE_H
 #define EYEDEA_ER_IMAGE_H
 
+#include <stddef.h>
+
 #include "er_explink.h"
 
 /* ***************************************************************************
@@ -41,7 +43,26 @@ typedef enum {
  * Eg. ER_IMAGE_COLORMODEL_BGR image with ER_IMAGE_DATATYPE_UCHAR takes      *
  * 3 bytes per pixel.                                                        *
  * NOTE: ER_IMAGE_COLORMODEL_YCBCR420 and ER_IMAGE_COLORMODEL_YCBCRNV12      *
- * color models are supported as an crop image input only.                   *
+ * color models are supported with ER_IMAGE_DATATYPE_UCHAR only. They are    *
+ * accepted as a full frame input of lpmRunDet() and lpmRunOcr() since       *
+ * LPM 7.7 (crop image input only in older versions). The luma plane is      *
+ * then read directly and the chroma planes are converted only inside the    *
+ * scanned area, so decoder output needs no conversion to BGR.               *
+ * Layout of the YCbCr color models (width and height must be even):         *
+ * - luma: height rows of width bytes, row r at data + r * step,             *
+ * - chroma starts right after the luma rows at data + step * height,        *
+ * - NV12: height / 2 rows of width bytes of interleaved Cb, Cr pairs,       *
+ *   row r at data + step * height + r * step,                               *
+ * - I420: the Cb plane followed by the Cr plane, each of height / 2 rows    *
+ *   of width / 2 bytes with the step / 2 row step; Cb row r at              *
+ *   data + step * height + r * (step / 2) and Cr row r at                   *
+ *   data + step * height + (step / 2) * (height / 2) + r * (step / 2).      *
+ * There is no separate chroma pointer or chroma step, so a decoder buffer   *
+ * with the chroma at an aligned offset (e.g. after 1088 luma rows of a      *
+ * 1080p frame) cannot be described as a 1080-row image. Describe it with    *
+ * the aligned height instead (1088, the chroma then starts where the        *
+ * decoder put it) and restrict the detection area to the real 1080 rows     *
+ * by the bounding box; padding of other sizes needs a copy.                 *
  * ***************************************************************************/
 typedef enum {
     ER_IMAGE_DATATYPE_UNK   = 0,        /* Unknown data type */
@@ -67,11 +88,145 @@ typedef struct
     unsigned int      size;             /*!< Byte size of the image data (step * height) */
     unsigned int      data_size;        /*!< Byte size of the allocated data */
     unsigned char*    data;             /*!< Pointer to the image data, interleaved if num_channels > 1 */
-    unsigned char**   row_data;         /*!< pointer to pointers to the image row data */
-    unsigned char     data_allocated;   /*!< flag if structure use self allocated data */
+    unsigned char**   row_data;         /*!< pointer to pointers to the image row data, NULL for views (see erImageInitView) */
+    unsigned char     data_allocated;   /*!< flag if structure use self allocated data, one of ER_IMAGE_DATA_* values */
 } ERImage;
 
 
+/* ***************************************************************************
+ * IMAGE DATA OWNERSHIP                                                      *
+ * Values of the ERImage data_allocated flag.                                *
+ * Views are described by data and step only, they own no memory and have    *
+ * no row_data. For views with negative row step, data points to the first   *
+ * (top) row, step holds the absolute value of the row step and the rows     *
+ * follow at decreasing addresses. Views have size = step * height (with     *
+ * 3/2 of height for YCbCr color models), which is the byte size spanned by  *
+ * the rows and not necessarily starting at data, and data_size = 0.         *
+ * Code computing data + row * step or copying size bytes from data is wrong *
+ * for negative views, use erImageGetRow() to access the rows of any image.  *
+ * Negative views are accepted as input by erImageCopy(), erImageWrite(),    *
+ * erImageConvert(), erImageResize(), erImagePyramidBuild() and by the LPM   *
+ * functions taking images (lpmRunDet(), lpmRunOcr(), lpmGetDetectionCrop()  *
+ * and their variants). They are rejected as the destination of any          *
+ * function and all the images created by the library have positive step.    *
+ * YCbCr color models have no negative views, erImageInitView() rejects a    *
+ * negative step for them, since their chroma planes follow the luma rows.   *
+ * ***************************************************************************/
+#define ER_IMAGE_DATA_EXTERNAL          0   /* Data buffer owned by the caller, row_data allocated */
+#define ER_IMAGE_DATA_ALLOCATED         1   /* Data buffer and row_data allocated */
+#define ER_IMAGE_DATA_VIEW              2   /* View with positive row step */
+#define ER_IMAGE_DATA_VIEW_NEGATIVE     3   /* View with negative row step */
+#define ER_IMAGE_DATA_POOLED            4   /* Data buffer and row_data owned by an ERImagePool */
+
+
+/* ***************************************************************************
+ * SIMD INSTRUCTION SETS                                                     *
+ * Instruction sets used by the ERImage conversion kernels. The best one     *
+ * supported by the CPU is selected at runtime, all of them produce          *
+ * bit-exact results of the scalar implementation.                           *
+ * ***************************************************************************/
+typedef enum {
+    ER_IMAGE_SIMD_NONE = 0,             /* Scalar implementation */
+    ER_IMAGE_SIMD_SSE4 = 1,             /* x86 SSE4.1 */
+    ER_IMAGE_SIMD_AVX2 = 2,             /* x86 AVX2 */
+    ER_IMAGE_SIMD_NEON = 3              /* ARM NEON */
+} ERImageSimdLevel;
+
+
+/* ***************************************************************************
+ * COLOR CONVERSION FORMULAS                                                 *
+ * erImageConvert() computes the following integer formulas exactly, with R, *
+ * G, B in 0..255 and >> an arithmetic shift:                                *
+ *   GRAY = (299 R + 587 G + 114 B + 500) / 1000                             *
+ *   Y    = (66 R + 129 G + 25 B + 4224) >> 8                                *
+ *   Cb   = (-38 R - 74 G + 112 B + 32896) >> 8                              *
+ *   Cr   = (112 R - 94 G - 18 B + 32896) >> 8                               *
+ * i.e. BT.601 luma for GRAY and limited-range BT.601 for YCbCr. Cb and Cr   *
+ * of a 2x2 block are computed from its average R, G and B, each rounded as  *
+ * (sum + 2) >> 2. The alpha of BGRA is set to 255 and dropped. The YCbCr    *
+ * to BGR direction is the inverse transform, rounded to the nearest value   *
+ * and clamped, so a round trip is not exact. I420 and NV12 convert to each  *
+ * other by a lossless reordering of the chroma samples.                     *
+ * ***************************************************************************/
+
+
+/* ***************************************************************************
+ * IMAGE INTERPOLATION METHODS                                               *
+ * Interpolation methods used by erImageResize() and erImagePyramidBuild().  *
+ * ***************************************************************************/
+typedef enum {
+    ER_IMAGE_INTERPOLATION_NEAREST = 0, /* Nearest neighbour */
+    ER_IMAGE_INTERPOLATION_LINEAR  = 1, /* Bilinear interpolation */
+    ER_IMAGE_INTERPOLATION_AREA    = 2  /* Pixel area averaging, best for downscaling */
+} ERImageInterpolation;
+
+
+/* ***************************************************************************
+ * IMAGE PYRAMID                                                             *
+ * Multi-scale representation of a single image. It is built once per frame  *
+ * by erImagePyramidBuild() and can be passed to every LPM module and stage  *
+ * working on that frame instead of resampling the frame again.              *
+ * ***************************************************************************/
+typedef struct
+{
+    ERImage           source;           /*!< View of the source image, its data must stay valid while the pyramid is used */
+    unsigned int      num_levels;       /*!< Number of pyramid levels */
+    ERImage*          levels;           /*!< Array of num_levels resampled images ordered from the largest one */
+    float*            scales;           /*!< Array of num_levels scales of the levels relative to the source image */
+} ERImagePyramid;
+
+
+/* ***************************************************************************
+ * IMAGE DECODING OPTIONS                                                    *
+ * Options of erImageDecode(), unused values must be zero-initialized.       *
+ * The region of interest is given in full-resolution pixel coordinates and  *
+ * only the image blocks covering it are decoded.                            *
+ * Output geometry with d = scale_denom (1 if 0):                            *
+ * - the whole image is decoded to ceil(W / d) x ceil(H / d) pixels, where   *
+ *   W x H is the full-resolution size,                                      *
+ * - a region of interest is clipped to the image (a region outside of it    *
+ *   is an error) and cropped exactly, not to the decoded block boundaries:  *
+ *   the output holds the pixels floor(roi_col / d) ..                       *
+ *   ceil((roi_col + roi_width) / d) - 1 of the columns of the downscaled    *
+ *   whole image, and likewise for the rows,                                 *
+ * - so an output pixel (x, y) covers the d x d full-resolution pixels      *
+ *   from ((x + floor(roi_col / d)) * d, (y + floor(roi_row / d)) * d),     *
+ *   which maps detections back to frame coordinates.                       *
+ * ***************************************************************************/
+typedef struct
+{
+    unsigned int      scale_denom;      /*!< Downscaling factor 1, 2, 4 or 8 (JPEG images are downscaled in the DCT domain), 0 for full resolution */
+    unsigned int      roi_col;          /*!< Left column of the region of interest */
+    unsigned int      roi_row;          /*!< Top row of the region of interest */
+    unsigned int      roi_width;        /*!< Width of the region of interest, 0 to decode the whole image */
+    unsigned int      roi_height;       /*!< Height of the region of interest, 0 to decode the whole image */
+    ERImageColorModel color_model;      /*!< Color model of the decoded image, ER_IMAGE_COLORMODEL_UNK to keep BGR or GRAY by the source */
+} ERImageDecodeOptions;
+
+
+/* ***************************************************************************
+ * IMAGE BUFFER POOL                                                         *
+ * ERImagePool holds a fixed number of pre-allocated page-aligned buffers    *
+ * of a single image geometry. Images acquired from the pool must be given   *
+ * back by erImagePoolRelease(), erImageFree() does nothing for them.        *
+ * Acquire and release can be called from different threads concurrently.    *
+ * ***************************************************************************/
+typedef struct ERImagePool ERImagePool;
+
+#define ER_IMAGE_POOL_HUGE_PAGES        0x01    /* Back the buffers by huge pages if available, standard pages otherwise */
+
+typedef struct
+{
+    unsigned int       capacity;            /*!< Number of buffers in the pool */
+    unsigned int       num_in_use;          /*!< Number of buffers currently acquired */
+    unsigned int       high_water_mark;     /*!< Maximal number of buffers acquired at the same time */
+    unsigned long long num_acquired;        /*!< Number of successful erImagePoolAcquire() calls */
+    unsigned long long num_exhausted;       /*!< Number of erImagePoolAcquire() calls failed because all buffers were in use */
+    size_t             reserved_size;       /*!< Byte size of the memory reserved by the pool */
+    unsigned char      huge_pages;          /*!< Flag if the buffers are backed by huge pages */
+} ERImagePoolStats;
+
+
 /* ***************************************************************************
  * HELPER FUNCTIONS FOR ERImage                                              *
  * ***************************************************************************/
@@ -85,6 +240,9 @@ ER_FUNCTION_PREFIX int          erImageAllocateBlank(ERImage* image, unsigned in
 /** Allocate dynamic fields but data buffer and fill the ERImage structure, the input data buffer is used for image data  */
 ER_FUNCTION_PREFIX int          erImageAllocateAndWrap(ERImage* image, unsigned int width, unsigned int height, ERImageColorModel color_model, ERImageDataType data_type, unsigned char* data, unsigned int step);
 
+/** Fill the ERImage structure as a view of the given data buffer without any allocation; data points to the top row, so for a bottom-up buffer with a negative step it is buffer + (height - 1) * |step|; a negative step is rejected for YCbCr color models */
+ER_FUNCTION_PREFIX int          erImageInitView(ERImage* image, unsigned int width, unsigned int height, ERImageColorModel color_model, ERImageDataType data_type, unsigned char* data, int step);
+
 /** Get byte size of given data type */
 ER_FUNCTION_PREFIX unsigned int erImageGetDataTypeSize(ERImageDataType data_type);
 
@@ -97,15 +255,51 @@ ER_FUNCTION_PREFIX unsigned int erImageGetPixelDepth(ERImageColorModel color_mod
 /** Deep copy of image */
 ER_FUNCTION_PREFIX int          erImageCopy(const ERImage* image, ERImage* image_copy);
 
+/** Convert image to another color model (ER_IMAGE_DATATYPE_UCHAR images only); dst is allocated if its data is NULL, otherwise it must have the target geometry and it is overwritten; see COLOR CONVERSION FORMULAS for the exact results */
+ER_FUNCTION_PREFIX int          erImageConvert(const ERImage* src, ERImage* dst, ERImageColorModel color_model);
+
+/** Get SIMD instruction set used by the conversion kernels */
+ER_FUNCTION_PREFIX ERImageSimdLevel erImageGetSimdLevel(void);
+
+/** Limit SIMD instruction set used by the conversion kernels (e.g. ER_IMAGE_SIMD_NONE to get the scalar reference), returns the level in use */
+ER_FUNCTION_PREFIX ERImageSimdLevel erImageSetMaxSimdLevel(ERImageSimdLevel level);
+
+/** Resize image using the vectorized kernels; dst is allocated if its data is NULL, otherwise it must have the target geometry and it is overwritten */
+ER_FUNCTION_PREFIX int          erImageResize(const ERImage* src, ERImage* dst, unsigned int width, unsigned int height, ERImageInterpolation interpolation);
+
+/** Build pyramid of the image with the given scales (less than or equal to 1); a zero-initialized pyramid is allocated, a pyramid of the same geometry is rebuilt in place */
+ER_FUNCTION_PREFIX int          erImagePyramidBuild(ERImagePyramid* pyramid, const ERImage* image, const float* scales, unsigned int num_scales, ERImageInterpolation interpolation);
+
+/** Free dynamic fields of ERImagePyramid */
+ER_FUNCTION_PREFIX void         erImagePyramidFree(ERImagePyramid* pyramid);
+
 /** Read image from file */
 ER_FUNCTION_PREFIX int          erImageRead(ERImage* image, const char *filename);
 
+/** Decode image from a memory buffer (e.g. JPEG blob), options may be NULL to decode the whole image at full resolution */
+ER_FUNCTION_PREFIX int          erImageDecode(ERImage* image, const void* buffer, size_t length, const ERImageDecodeOptions* options);
+
 /** Write image to file */
 ER_FUNCTION_PREFIX int          erImageWrite(const ERImage* image, const char* filename);
 
-/** Free dynamic fields of ERImage */
+/** Free dynamic fields of ERImage, does nothing for views and pooled images */
 ER_FUNCTION_PREFIX void         erImageFree(ERImage *image);
 
+/** Create pool of capacity pre-allocated image buffers of the given geometry, flags are ER_IMAGE_POOL_* values */
+ER_FUNCTION_PREFIX int          erImagePoolCreate(ERImagePool** pool, unsigned int width, unsigned int height, ERImageColorModel color_model, ERImageDataType data_type, unsigned int capacity, unsigned int flags);
+
+/** Fill the ERImage structure with a free buffer of the pool, fails without blocking if all buffers are in use */
+ER_FUNCTION_PREFIX int          erImagePoolAcquire(ERImagePool* pool, ERImage* image);
+
+/** Give the image acquired by erImagePoolAcquire back to the pool */
+ER_FUNCTION_PREFIX void         erImagePoolRelease(ERImagePool* pool, ERImage* image);
+
+/** Get usage statistics of the pool */
+ER_FUNCTION_PREFIX int          erImagePoolGetStats(const ERImagePool* pool, ERImagePoolStats* stats);
+
+/** Free the pool and all its buffers, all images must be released before */
+ER_FUNCTION_PREFIX void         erImagePoolFree(ERImagePool** pool);
+
 /** Get string with version of ERImage */
 ER_FUNCTION_PREFIX const char*  erVersion(void);
 
@@ -115,6 +309,16 @@ ER_FUNCTION_PREFIX const char*  erGetErrorLog(void);
 /** Reset error log, invalidates previous const char* obtained from erGetErrorLog() */
 ER_FUNCTION_PREFIX void erResetErrorLog(void);
 
+/** Get pointer to the data of the given row, works for views with negative row step as well */
+static inline unsigned char* erImageGetRow(const ERImage* image, unsigned int row)
+{
+    if (image->data_allocated == ER_IMAGE_DATA_VIEW_NEGATIVE)
+    {
+        return image->data - (size_t)row * image->step;
+    }
+    return image->data + (size_t)row * image->step;
+}
+
 /* function pointers types for explicit linking */
 typedef unsigned int (*fcn_erImageGetDataTypeSize)          (ERImageDataType);
 typedef unsigned int (*fcn_erImageGetColorModelNumChannels) (ERImageColorModel);
@@ -122,10 +326,23 @@ typedef unsigned int (*fcn_erImageGetPixelDepth)            (ERImageColorModel,
 typedef int          (*fcn_erImageAllocateBlank)            (ERImage*, unsigned int, unsigned int, ERImageColorModel, ERImageDataType);
 typedef int          (*fcn_erImageAllocate)                 (ERImage*, unsigned int, unsigned int, ERImageColorModel, ERImageDataType);
 typedef int          (*fcn_erImageAllocateAndWrap)          (ERImage*, unsigned int, unsigned int, ERImageColorModel, ERImageDataType, unsigned char*, unsigned int);
+typedef int          (*fcn_erImageInitView)                 (ERImage*, unsigned int, unsigned int, ERImageColorModel, ERImageDataType, unsigned char*, int);
 typedef int          (*fcn_erImageCopy)                     (const ERImage*, ERImage*);
+typedef int          (*fcn_erImageConvert)                  (const ERImage*, ERImage*, ERImageColorModel);
+typedef ERImageSimdLevel (*fcn_erImageGetSimdLevel)         (void);
+typedef ERImageSimdLevel (*fcn_erImageSetMaxSimdLevel)      (ERImageSimdLevel);
+typedef int          (*fcn_erImageResize)                   (const ERImage*, ERImage*, unsigned int, unsigned int, ERImageInterpolation);
+typedef int          (*fcn_erImagePyramidBuild)             (ERImagePyramid*, const ERImage*, const float*, unsigned int, ERImageInterpolation);
+typedef void         (*fcn_erImagePyramidFree)              (ERImagePyramid*);
 typedef int          (*fcn_erImageRead)                     (ERImage*, const char*);
+typedef int          (*fcn_erImageDecode)                   (ERImage*, const void*, size_t, const ERImageDecodeOptions*);
 typedef int          (*fcn_erImageWrite)                    (const ERImage*, const char*);
 typedef void         (*fcn_erImageFree)                     (ERImage*);
+typedef int          (*fcn_erImagePoolCreate)               (ERImagePool**, unsigned int, unsigned int, ERImageColorModel, ERImageDataType, unsigned int, unsigned int);
+typedef int          (*fcn_erImagePoolAcquire)              (ERImagePool*, ERImage*);
+typedef void         (*fcn_erImagePoolRelease)              (ERImagePool*, ERImage*);
+typedef int          (*fcn_erImagePoolGetStats)             (const ERImagePool*, ERImagePoolStats*);
+typedef void         (*fcn_erImagePoolFree)                 (ERImagePool**);
 typedef const char*  (*fcn_erVersion)                       (void);
 typedef const char*  (*fcn_erGetErrorLog)                   (void);
 typedef void         (*fcn_erResetErrorLog)                 (void);
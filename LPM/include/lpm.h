@@ -50,26 +50,88 @@ extern "C"
 /* ======================================================== */
 
 typedef int                  (*fcn_lpmInit)(const char *, LPMState *);
+typedef int                  (*fcn_lpmInitEx)(const char *, LPMState *, const LpmInitConfig *);
 typedef void                 (*fcn_lpmFree)(LPMState *);
 typedef unsigned long        (*fcn_lpmVersion)(void);
 typedef char const          *(*fcn_lpmCompilationDate)(void);
 
 typedef int                  (*fcn_lpmLoadViewConfig)(const char *, LpmCameraViewParams *);
 typedef int                  (*fcn_lpmWriteViewConfig)(const char *, LpmCameraViewParams);
+typedef int                  (*fcn_lpmLoadResolutionMap)(const char *, LpmResolutionMap *);
+typedef int                  (*fcn_lpmWriteResolutionMap)(const char *, const LpmResolutionMap *);
+typedef void                 (*fcn_lpmFreeResolutionMap)(LpmResolutionMap *);
 
 typedef int                  (*fcn_lpmLoadModule)(LPMState, int, LpmCameraViewParams *, const LpmModuleConfig *);
+typedef int                  (*fcn_lpmLoadModuleInstance)(LPMState, int, LpmCameraViewParams *, const LpmModuleConfig *, int *);
 typedef void                 (*fcn_lpmFreeModule)(LPMState, int);
+typedef int                  (*fcn_lpmReloadModule)(LPMState, int, int, const char *, LpmCameraViewParams *, const LpmModuleConfig *);
+typedef int                  (*fcn_lpmWarmupModule)(LPMState, int, const ERImage *, int, double *);
+typedef int                  (*fcn_lpmSetModuleThreads)(LPMState, int, int, int);
+typedef int                  (*fcn_lpmGetModuleThreads)(LPMState, int, int *, int *);
+typedef int                  (*fcn_lpmSaveModuleSnapshot)(LPMState, int, const char *);
+typedef int                  (*fcn_lpmLoadModuleSnapshot)(LPMState, const char *, int *);
+
+typedef int                  (*fcn_lpmRegisterViewProfile)(LPMState, int, const LpmCameraViewParams *);
+typedef void                 (*fcn_lpmUnregisterViewProfile)(LPMState, int, int);
+typedef int                  (*fcn_lpmSetViewProfileResolutionMap)(LPMState, int, int, const LpmResolutionMap *);
 
 typedef LpmDetResult        *(*fcn_lpmRunDet)(LPMState, int, ERImage, const LpmBoundingBox *);
 typedef void                 (*fcn_lpmFreeDetResult)(LPMState, LpmDetResult *);
+typedef LpmDetResult        *(*fcn_lpmRunDetEx)(LPMState, int, ERImage, const LpmDetParams *);
+typedef int                  (*fcn_lpmGetPyramidScales)(LPMState, int, int, float *, int);
+typedef int                  (*fcn_lpmGetDetectionCrop)(LPMState, const LpmDetResult *, int, ERImage, unsigned int, unsigned int, ERImageColorModel, ERImage *);
+typedef LpmDetResult        *(*fcn_lpmRunDetBatch)(LPMState, int, const ERImage *, const LpmBoundingBox *, int);
+typedef LpmDetResult        *(*fcn_lpmRunDetBatchEx)(LPMState, int, const ERImage *, const LpmDetParams *, int);
+typedef void                 (*fcn_lpmFreeDetResultBatch)(LPMState, LpmDetResult *, int);
 
 typedef LpmOcrResult        *(*fcn_lpmRunOcr)(LPMState, int, ERImage, const LpmBoundingBox *, LpmDetectionLabel);
 typedef void                 (*fcn_lpmFreeOcrResult)(LPMState, LpmOcrResult *);
+typedef LpmOcrResult        *(*fcn_lpmRunOcrPyramid)(LPMState, int, const ERImagePyramid *, const LpmBoundingBox *, LpmDetectionLabel);
+typedef LpmOcrResult        *(*fcn_lpmRunOcrBatch)(LPMState, int, ERImage, const LpmBoundingBox *, const LpmDetectionLabel *, int);
+typedef void                 (*fcn_lpmFreeOcrResultBatch)(LPMState, LpmOcrResult *, int);
+
+typedef LpmDetOcrResult     *(*fcn_lpmRunDetOcr)(LPMState, int, ERImage, const LpmBoundingBox *, const LpmDetectionLabel *, int);
+typedef LpmDetOcrResult     *(*fcn_lpmRunDetOcrEx)(LPMState, int, ERImage, const LpmDetParams *, const LpmDetectionLabel *, int);
+typedef void                 (*fcn_lpmFreeDetOcrResult)(LPMState, LpmDetOcrResult *);
+
+typedef LpmResultArena       (*fcn_lpmCreateResultArena)(LPMState, size_t);
+typedef void                 (*fcn_lpmFreeResultArena)(LPMState, LpmResultArena *);
+typedef size_t               (*fcn_lpmGetResultArenaCapacity)(LpmResultArena);
+typedef LpmDetResult        *(*fcn_lpmRunDetInto)(LPMState, int, ERImage, const LpmDetParams *, LpmResultArena);
+typedef LpmOcrResult        *(*fcn_lpmRunOcrInto)(LPMState, int, ERImage, const LpmBoundingBox *, LpmDetectionLabel, LpmResultArena);
+
+typedef LpmWorker            (*fcn_lpmCreateWorker)(LPMState, int);
+typedef void                 (*fcn_lpmFreeWorker)(LpmWorker *);
+typedef int                  (*fcn_lpmWarmupWorker)(LpmWorker, const ERImage *, int, double *);
+typedef LpmDetResult        *(*fcn_lpmWorkerRunDet)(LpmWorker, ERImage, const LpmBoundingBox *);
+typedef LpmDetResult        *(*fcn_lpmWorkerRunDetEx)(LpmWorker, ERImage, const LpmDetParams *);
+typedef LpmOcrResult        *(*fcn_lpmWorkerRunOcr)(LpmWorker, ERImage, const LpmBoundingBox *, LpmDetectionLabel);
+
+typedef LpmMotionGate        (*fcn_lpmCreateMotionGate)(LPMState, const LpmMotionGateConfig *);
+typedef void                 (*fcn_lpmFreeMotionGate)(LpmMotionGate *);
+typedef void                 (*fcn_lpmResetMotionGate)(LpmMotionGate);
+typedef int                  (*fcn_lpmMotionGateUpdate)(LpmMotionGate, ERImage);
+typedef int                  (*fcn_lpmGetMotionGateStats)(LpmMotionGate, LpmMotionGateStats *);
+
+typedef LpmTracker           (*fcn_lpmCreateTracker)(LPMState, int, int, const LpmTrackerConfig *);
+typedef void                 (*fcn_lpmFreeTracker)(LpmTracker *);
+typedef int                  (*fcn_lpmTrackerPush)(LpmTracker, ERImage, const LpmBoundingBox *, double);
+typedef int                  (*fcn_lpmTrackerPushEx)(LpmTracker, ERImage, const LpmDetParams *, double);
+typedef int                  (*fcn_lpmTrackerFlush)(LpmTracker);
+typedef LpmTrackResult      *(*fcn_lpmTrackerGetFinishedTracks)(LpmTracker);
+typedef void                 (*fcn_lpmFreeTrackResult)(LPMState, LpmTrackResult *);
+
+typedef LpmTicket            (*fcn_lpmSubmitDet)(LPMState, int, ERImage, const LpmBoundingBox *, LpmCompletionCallback, void *);
+typedef LpmTicket            (*fcn_lpmSubmitDetEx)(LPMState, int, ERImage, const LpmDetParams *, LpmCompletionCallback, void *);
+typedef LpmTicket            (*fcn_lpmSubmitOcr)(LPMState, int, ERImage, const LpmBoundingBox *, LpmDetectionLabel, LpmCompletionCallback, void *);
+typedef int                  (*fcn_lpmPoll)(LPMState, LpmTicket);
+typedef int                  (*fcn_lpmWait)(LPMState, LpmTicket, int, LpmAsyncResult *);
 
 typedef int                  (*fcn_lpmGetNumAvlbModules)(LPMState);
 typedef int                  (*fcn_lpmGetModuleIndex)(LPMState, int, int, int);
 typedef int                  (*fcn_lpmGetModuleIndexByName)(LPMState, const char *);
 typedef LpmModuleInfo       *(*fcn_lpmGetModuleInfo)(LPMState, int);
+typedef int                  (*fcn_lpmGetModuleFootprint)(LPMState, int, LpmModuleInfo_extension1 *);
 
 typedef int                  (*fcn_lpmGetLastError)(void);
 
@@ -100,6 +162,25 @@ typedef int                  (*fcn_lpmGetLastError)(void);
 ER_FUNCTION_PREFIX int lpmInit(const char *lpm_directory, LPMState *lpm_state);
 
 
+/*! \fn int lpmInitEx(const char *lpm_directory, LPMState *lpm_state, const LpmInitConfig *init_config)
+
+    \brief  Initializes the LPM engine with additional configuration.
+
+    With LpmInitConfig::lazy_discovery enabled, the directory is only enumerated and the modules are opened on their
+    first use: lpmGetModuleIndex() and lpmGetModuleIndexByName() read just the descriptors of the modules,
+    lpmGetModuleInfo() and lpmLoadModule() open the whole module.
+
+    \param  lpm_directory LPM module base directory (e.g. "../../modules-v[VERSION]/x64").
+    \param  lpm_state     LPM state structure (LPM context) to be initialized.
+    \param  init_config   Pointer to optional initialization configuration. Use NULL to behave as lpmInit().
+
+    \return 0 on success, non-zero otherwise.
+
+    \see    lpmInit, lpmFree
+*/
+ER_FUNCTION_PREFIX int lpmInitEx(const char *lpm_directory, LPMState *lpm_state, const LpmInitConfig *init_config);
+
+
 /*! \fn void lpmFree(LPMState *lpm_state)
 
     \brief  Frees the initialized LPM engine.
@@ -151,14 +232,15 @@ ER_FUNCTION_PREFIX char const *lpmCompilationDate(void);
 
 /*! \fn LpmCameraViewParams lpmLoadViewConfig(const char *filename, LpmCameraViewParams *camera_view_params)
 
-    \brief  Loads the camera view parameters from file.
+    \brief  Loads the camera view parameters from file. The resolution map section of the file, if any, is ignored
+            (see lpmLoadResolutionMap()).
 
     \param  filename            Path to a file, from which the config should be loaded, or NULL to use default parameters.
     \param  camera_view_params  Structure to be loaded with parameters from a given file.
 
     \return Zero on success, error code otherwise.
 
-    \see    lpmWriteViewConfig
+    \see    lpmWriteViewConfig, lpmLoadResolutionMap
 */
 ER_FUNCTION_PREFIX int lpmLoadViewConfig(const char *filename, LpmCameraViewParams *camera_view_params);
 
@@ -167,15 +249,61 @@ ER_FUNCTION_PREFIX int lpmLoadViewConfig(const char *filename, LpmCameraViewPara
 
     \brief  Writes the camera view parameters to a given file.
 
+    Only the camera view parameters in the file are replaced. The resolution map section written by
+    lpmWriteResolutionMap() is kept if the file already contains it, so both functions can update the same file
+    in any order.
+
     \param  filename            Path to the file where camera view parameters will be written.
     \param  camera_view_params  Pointer to LpmCameraViewParams to write.
 
     \return 0 - File was successfully written, other - Error while saving file.
 
-    \see    lpmLoadViewConfig
+    \see    lpmLoadViewConfig, lpmWriteResolutionMap
 */
 ER_FUNCTION_PREFIX int lpmWriteViewConfig(const char *filename, LpmCameraViewParams camera_view_params);
 
+
+/*! \fn int lpmLoadResolutionMap(const char *filename, LpmResolutionMap *resolution_map)
+
+    \brief  Loads the resolution map from a camera view config file.
+
+    The map is stored in its own section of the same file as the camera view parameters, so a single file
+    describes the whole camera view.
+
+    \param  filename        Path to a file, from which the map should be loaded.
+    \param  resolution_map  Structure to be loaded with the map, to be freed by lpmFreeResolutionMap(). A file without the map gives zero bands.
+
+    \return Zero on success, error code otherwise.
+
+    \see    lpmWriteResolutionMap, lpmLoadViewConfig, lpmSetViewProfileResolutionMap
+*/
+ER_FUNCTION_PREFIX int lpmLoadResolutionMap(const char *filename, LpmResolutionMap *resolution_map);
+
+
+/*! \fn int lpmWriteResolutionMap(const char *filename, const LpmResolutionMap *resolution_map)
+
+    \brief  Writes the resolution map to a camera view config file, the camera view parameters in the file are kept.
+
+    \param  filename        Path to the file where the map will be written.
+    \param  resolution_map  Pointer to LpmResolutionMap to write.
+
+    \return 0 - File was successfully written, other - Error while saving file.
+
+    \see    lpmLoadResolutionMap, lpmWriteViewConfig
+*/
+ER_FUNCTION_PREFIX int lpmWriteResolutionMap(const char *filename, const LpmResolutionMap *resolution_map);
+
+
+/*! \fn void lpmFreeResolutionMap(LpmResolutionMap *resolution_map)
+
+    \brief  Frees the bands of the resolution map loaded by lpmLoadResolutionMap().
+
+    \param  resolution_map  Pointer to the resolution map to be freed.
+
+    \see    lpmLoadResolutionMap
+*/
+ER_FUNCTION_PREFIX void lpmFreeResolutionMap(LpmResolutionMap *resolution_map);
+
 /*!  @} */
 
 
@@ -207,6 +335,37 @@ ER_FUNCTION_PREFIX int lpmWriteViewConfig(const char *filename, LpmCameraViewPar
 ER_FUNCTION_PREFIX int lpmLoadModule(LPMState lpm_state, int module_index, LpmCameraViewParams *camera_view_params, const LpmModuleConfig *module_config);
 
 
+/*! \fn int lpmLoadModuleInstance(LPMState lpm_state, int module_index, LpmCameraViewParams *camera_view_params, const LpmModuleConfig *module_config, int *instance_index)
+
+    \brief  Loads another instance of an LPM module, e.g. one instance per NUMA node with its own affinity
+            (see LpmModuleConfig_extension2::affinity).
+
+    The instance gets a new module index, which is used in all the functions taking a module index and freed by
+    lpmFreeModule(). Without a NUMA node in its affinity the instance shares the weights of the instances loaded
+    before. With use_numa_node set the weights are node-local: the instance shares them only with instances on the
+    same node and otherwise gets its own copy on its node, unless share_weights_across_nodes of its affinity opts in
+    to sharing the weights of an instance on another node.
+
+    Instance indices are greater than or equal to lpmGetNumAvlbModules(), so the available modules keep the indices
+    0 .. lpmGetNumAvlbModules() - 1 and are not affected by the instances, and lpmGetModuleIndex() and
+    lpmGetModuleIndexByName() never return an instance index. lpmGetModuleInfo() on an instance index returns the
+    information of the module the instance was loaded from (name, id, path, version, ...), lpmGetModuleFootprint()
+    reports the footprint of the instance itself. An instance index freed by lpmFreeModule() may be reused by a later
+    lpmLoadModuleInstance() call.
+
+    \param  lpm_state           The LPM state created by the lpmInit() function.
+    \param  module_index        Index of the LPM module to load an instance of, it does not need to be loaded by lpmLoadModule().
+    \param  camera_view_params  Pointer to optional camera view parameters. Use NULL for default parameters.
+    \param  module_config       Pointer to optional module configuration parameters. Use NULL to load values from configuration file.
+    \param  instance_index      Pointer to be filled with the module index of the loaded instance.
+
+    \return 0 - the instance was successfully initialized, other - Error while initializing the instance.
+
+    \see lpmLoadModule, lpmFreeModule, lpmGetModuleIndex
+*/
+ER_FUNCTION_PREFIX int lpmLoadModuleInstance(LPMState lpm_state, int module_index, LpmCameraViewParams *camera_view_params, const LpmModuleConfig *module_config, int *instance_index);
+
+
 /*! \fn void lpmFreeModule(LPMState lpm_state, int module_index)
 
     \brief  Frees previously loaded LPM module with the given index.
@@ -218,10 +377,205 @@ ER_FUNCTION_PREFIX int lpmLoadModule(LPMState lpm_state, int module_index, LpmCa
 */
 ER_FUNCTION_PREFIX void lpmFreeModule(LPMState lpm_state, int module_index);
 
+
+/*! \fn int lpmReloadModule(LPMState lpm_state, int module_index, int new_module_index, const char *new_module_path, LpmCameraViewParams *camera_view_params, const LpmModuleConfig *module_config)
+
+    \brief  Replaces a loaded LPM module by another version without interrupting the processing.
+
+    The new module is built and warmed up (as by lpmWarmupModule() with the default sample image and iterations,
+    for the camera view parameters and all the registered view profiles) while other threads keep processing on
+    the old one, so the first calls after the switch run at the steady-state speed. Then the module is switched
+    atomically: new calls, workers, trackers and queued asynchronous requests use the new module, while the calls
+    running on the old module are drained and the old module is freed before the function returns. The memory
+    therefore peaks at two copies of the module and falls back to one. The module index, the view profiles and
+    their resolution maps stay valid. If the new module cannot be loaded, the old one is kept.
+
+    After the switch:
+     - lpmGetModuleInfo() on module_index reports the new module (its name, ID, version and path) in a new
+       structure. The structures obtained before the switch are not freed with the old module, they stay valid
+       and keep describing the old module until lpmFree().
+     - The module at new_module_index is not loaded by the reload, it stays available and can be loaded on its
+       own by lpmLoadModule() (as a separate copy). new_module_index can be equal to module_index to reload the
+       same module, e.g. with a new configuration.
+     - The results carry module_index in lpm_idx and the ID of the module which computed them in lpm_id, i.e. the
+       ID of the old module for the calls drained from it and the ID of the new module for all the later calls.
+
+    \param  lpm_state           The LPM state created by lpmInit() function.
+    \param  module_index        Index of the loaded LPM module to replace.
+    \param  new_module_index    Index of the module to load instead (e.g. from lpmGetModuleIndex() with zero version), or -1 to use new_module_path.
+    \param  new_module_path     Path to the directory of the module to load instead, used only if new_module_index is -1.
+    \param  camera_view_params  Pointer to optional camera view parameters. Use NULL to keep the parameters of the old module.
+    \param  module_config       Pointer to optional module configuration parameters. Use NULL to keep the configuration of the old module.
+
+    \return 0 - The module was successfully replaced, other - Error while loading the new module.
+
+    \see    lpmLoadModule, lpmGetModuleIndex, lpmGetModuleInfo
+*/
+ER_FUNCTION_PREFIX int lpmReloadModule(LPMState lpm_state, int module_index, int new_module_index, const char *new_module_path, LpmCameraViewParams *camera_view_params, const LpmModuleConfig *module_config);
+
+
+/*! \fn int lpmWarmupModule(LPMState lpm_state, int module_index, const ERImage *sample_image, int iterations, double *warmup_time_ms)
+
+    \brief  Warms up a loaded LPM module, so the first real lpmRunDet() and lpmRunOcr() calls run at the steady-state speed.
+
+    The warm-up runs the detector at every scale and the OCR at every input shape implied by the camera view
+    parameters of the module and of all its registered view profiles. It selects the compute kernels and
+    preallocates all the scratch memory of the module. Workers created by lpmCreateWorker() have their own scratch
+    buffers, which are not warmed up by this function, see lpmWarmupWorker().
+
+    \param  lpm_state       The LPM state created by lpmInit() function.
+    \param  module_index    Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  sample_image    Pointer to an image of the size and color model of the real input, or NULL to use a synthetic image of the module's default size.
+    \param  iterations      Number of warm-up iterations, the module's default is used if set to 0 or negative.
+    \param  warmup_time_ms  Pointer to be filled with the warm-up time in milliseconds, or NULL.
+
+    \return 0 - The module was successfully warmed up, other - Error code.
+
+    \see    lpmLoadModule, lpmRegisterViewProfile, lpmWarmupWorker
+*/
+ER_FUNCTION_PREFIX int lpmWarmupModule(LPMState lpm_state, int module_index, const ERImage *sample_image, int iterations, double *warmup_time_ms);
+
+
+/*! \fn int lpmSetModuleThreads(LPMState lpm_state, int module_index, int det_num_threads, int ocr_num_threads)
+
+    \brief  Resizes the CPU thread pools of a loaded LPM module without reloading it, e.g. after the CPU quota of the
+            container has changed.
+
+    The running calls finish with the old number of threads, the following calls use the new one. A value of 0 or
+    negative sizes the pool again from the logical processors currently available to the process, including the
+    current cgroup CPU quota (see det_num_threads and ocr_num_threads in LpmModuleConfig_extension1).
+    The function has no effect on the submodules computing on a GPU and on the modules using an LpmExecutor.
+
+    \param  lpm_state        The LPM state created by lpmInit() function.
+    \param  module_index     Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  det_num_threads  New number of threads of the detector.
+    \param  ocr_num_threads  New number of threads of the OCR.
+
+    \return 0 - The thread pools were successfully resized, other - Error code.
+
+    \see    lpmGetModuleThreads, lpmLoadModule
+*/
+ER_FUNCTION_PREFIX int lpmSetModuleThreads(LPMState lpm_state, int module_index, int det_num_threads, int ocr_num_threads);
+
+
+/*! \fn int lpmGetModuleThreads(LPMState lpm_state, int module_index, int *det_num_threads, int *ocr_num_threads)
+
+    \brief  Gets the current number of threads of the CPU thread pools of a loaded LPM module.
+
+    \param  lpm_state        The LPM state created by lpmInit() function.
+    \param  module_index     Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  det_num_threads  Pointer to be filled with the number of threads of the detector, or NULL.
+    \param  ocr_num_threads  Pointer to be filled with the number of threads of the OCR, or NULL.
+
+    \return 0 - Success, other - Error code.
+
+    \see    lpmSetModuleThreads
+*/
+ER_FUNCTION_PREFIX int lpmGetModuleThreads(LPMState lpm_state, int module_index, int *det_num_threads, int *ocr_num_threads);
+
+
+/*! \fn int lpmSaveModuleSnapshot(LPMState lpm_state, int module_index, const char *filename)
+
+    \brief  Saves a loaded LPM module in its fully initialized form (inference graphs, memory plan and resolved
+            configuration) to a single snapshot file.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of a loaded LPM module.
+    \param  filename      Path to the snapshot file to be written.
+
+    \return 0 - The snapshot was successfully written, other - Error code.
+
+    \see    lpmLoadModuleSnapshot, lpmLoadModule
+*/
+ER_FUNCTION_PREFIX int lpmSaveModuleSnapshot(LPMState lpm_state, int module_index, const char *filename);
+
+
+/*! \fn int lpmLoadModuleSnapshot(LPMState lpm_state, const char *filename, int *module_index)
+
+    \brief  Loads an LPM module from a snapshot file written by lpmSaveModuleSnapshot().
+
+    The snapshot is mapped into memory instead of being parsed and built, which makes the load take milliseconds.
+    A snapshot is bound to the engine version, the module version and the CPU features of the host it was saved on;
+    a snapshot which does not match is rejected and the module has to be loaded by lpmLoadModule() (and saved again).
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  filename      Path to the snapshot file.
+    \param  module_index  Pointer to be filled with the index of the loaded module.
+
+    \return 0 - The module was successfully loaded, other - Error code.
+
+    \see    lpmSaveModuleSnapshot, lpmLoadModule, lpmFreeModule
+*/
+ER_FUNCTION_PREFIX int lpmLoadModuleSnapshot(LPMState lpm_state, const char *filename, int *module_index);
+
 /*!  @} */ 
 
 
 
+/* ======================================================== */
+/*                                                          */
+/*  LPM CAMERA VIEW PROFILES                                */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMViewProfile  Camera view profiles
+ @{
+
+    A camera view profile binds another set of camera view parameters to an already loaded module,
+    so a single loaded module can serve cameras with different mounting geometry. The profile is
+    selected per call by LpmDetParams::view_profile. Profiles can be registered and removed while other
+    threads run the detection, a profile must not be removed while a call using it is running.
+*/
+
+/*! \fn int lpmRegisterViewProfile(LPMState lpm_state, int module_index, const LpmCameraViewParams *camera_view_params)
+
+    \brief  Registers camera view parameters as a new view profile of a loaded LPM module.
+
+    \param  lpm_state           The LPM state created by lpmInit() function.
+    \param  module_index        Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  camera_view_params  Camera view parameters of the profile.
+
+    \return -1 - Error during registration occurred, other - Positive handle of the view profile.
+
+    \see    lpmLoadModule, lpmUnregisterViewProfile, lpmRunDetEx, lpmLoadViewConfig
+*/
+ER_FUNCTION_PREFIX int lpmRegisterViewProfile(LPMState lpm_state, int module_index, const LpmCameraViewParams *camera_view_params);
+
+
+/*! \fn void lpmUnregisterViewProfile(LPMState lpm_state, int module_index, int view_profile)
+
+    \brief  Removes a view profile registered by lpmRegisterViewProfile().
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of the LPM module the profile was registered to.
+    \param  view_profile  Handle of the view profile to remove.
+
+    \see    lpmRegisterViewProfile
+*/
+ER_FUNCTION_PREFIX void lpmUnregisterViewProfile(LPMState lpm_state, int module_index, int view_profile);
+
+
+/*! \fn int lpmSetViewProfileResolutionMap(LPMState lpm_state, int module_index, int view_profile, const LpmResolutionMap *resolution_map)
+
+    \brief  Sets the perspective-aware resolution map of a view profile, so each image band is scanned only at the scales
+            which can hold a plate there.
+
+    \param  lpm_state       The LPM state created by lpmInit() function.
+    \param  module_index    Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  view_profile    Handle of a view profile registered by lpmRegisterViewProfile(), 0 for the camera view parameters given to lpmLoadModule().
+    \param  resolution_map  The resolution map, it is copied. Use NULL to scan all the scales in the whole image again.
+
+    \return 0 - Success, other - Error code.
+
+    \see    lpmRegisterViewProfile, lpmLoadResolutionMap
+*/
+ER_FUNCTION_PREFIX int lpmSetViewProfileResolutionMap(LPMState lpm_state, int module_index, int view_profile, const LpmResolutionMap *resolution_map);
+
+/*!  @} */
+
+
+
 /* ======================================================== */
 /*                                                          */
 /*  LP DETECTION FUNCTION                                   */
@@ -239,9 +593,14 @@ ER_FUNCTION_PREFIX void lpmFreeModule(LPMState lpm_state, int module_index);
 
     \param  lpm_state     The LPM state created by lpmInit() function.
     \param  module_index  Index of LPM module to use. Note that module index and module ID are two different things.
-    \param  image         ERImage structure containing the image for detection.
+    \param  image         ERImage structure containing the image for detection. Besides BGR, BGRA and GRAY images, full-frame
+                          YCbCr 4:2:0 (I420) and NV12 images are accepted without conversion; the chroma planes must follow the luma
+                          rows as described in er_image.h (IMAGE DATA TYPES, also for a chroma plane at an aligned offset).
     \param  bounding_box  The bounding box of a detection area.
 
+    \note   The image rows are accessed through data and step only, so views created by erImageInitView()
+            (including padded and negative-step buffers) can be passed without row_data.
+
     \return NULL - Error during computation occurred, other - LpmDetResult structure with all detections.
 
     \see    lpmInit, lpmLoadModule, lpmFreeDetResult
@@ -249,6 +608,46 @@ ER_FUNCTION_PREFIX void lpmFreeModule(LPMState lpm_state, int module_index);
 ER_FUNCTION_PREFIX LpmDetResult *lpmRunDet(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *bounding_box);
 
 
+/*! \fn LpmDetResult *lpmRunDetEx(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params)
+
+    \brief  Runs license/ADR plate detection on the given image with additional per-call parameters.
+
+    Masked pixels are skipped by the detector entirely, so restricting the scanned area to the traffic lanes
+    reduces the computation time accordingly.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  image         ERImage structure containing the image for detection.
+    \param  params        Parameters of the detection (detection areas, masks, view profile, ...), or NULL to behave as lpmRunDet() on the whole image.
+
+    \return NULL - Error during computation occurred, other - LpmDetResult structure with all detections.
+
+    \see    lpmRunDet, lpmRegisterViewProfile, lpmFreeDetResult
+*/
+ER_FUNCTION_PREFIX LpmDetResult *lpmRunDetEx(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params);
+
+
+/*! \fn int lpmGetPyramidScales(LPMState lpm_state, int module_index, int view_profile, float *scales, int max_scales)
+
+    \brief  Gets the image scales the detector of a module scans with the given camera view parameters.
+
+    The scales follow from the min_horizontal_resolution and max_horizontal_resolution of the camera view.
+    An image pyramid built by erImagePyramidBuild() with these scales (or with the union of the scales of several
+    modules run on the same frame) is used by lpmRunDetEx() and lpmRunOcrPyramid() without any further resampling.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  view_profile  Handle of a view profile registered by lpmRegisterViewProfile(), 0 for the camera view parameters given to lpmLoadModule().
+    \param  scales        Array to be filled with at most max_scales scales in descending order, or NULL to get the number of scales only.
+    \param  max_scales    Size of the scales array.
+
+    \return -1 - Error occurred, other - Number of scales needed (may be larger than max_scales).
+
+    \see    lpmRunDetEx, lpmRunOcrPyramid, erImagePyramidBuild
+*/
+ER_FUNCTION_PREFIX int lpmGetPyramidScales(LPMState lpm_state, int module_index, int view_profile, float *scales, int max_scales);
+
+
 /*! \fn void lpmFreeDetResult(LPMState lpm_state, LpmDetResult *detection_result)
 
     \brief  Frees detection result structure generated by lpmRunDet().
@@ -260,6 +659,89 @@ ER_FUNCTION_PREFIX LpmDetResult *lpmRunDet(LPMState lpm_state, int module_index,
 */ 
 ER_FUNCTION_PREFIX void lpmFreeDetResult(LPMState lpm_state, LpmDetResult *detection_result);
 
+
+/*! \fn int lpmGetDetectionCrop(LPMState lpm_state, const LpmDetResult *detection_result, int detection_index, ERImage image, unsigned int width, unsigned int height, ERImageColorModel color_model, ERImage *crop)
+
+    \brief  Generates the image crop of a detection on demand.
+
+    The crop is sampled from the source image using the detection's affine_mapping, which makes it possible to skip
+    the crop generation in the detector (see LpmModuleConfig_extension2::det_lazy_crops) and to generate crops only
+    for the detections which are really needed.
+
+    \param  lpm_state         The LPM state created by lpmInit() function.
+    \param  detection_result  Detection result structure generated by lpmRunDet() or a related function.
+    \param  detection_index   Index of the detection in the detection_result->detections array.
+    \param  image             ERImage structure containing the image the detection was run on.
+    \param  width             Width of the crop in pixels, 0 to use the width chosen by the detector.
+    \param  height            Height of the crop in pixels, 0 to use the height chosen by the detector.
+    \param  color_model       Color model of the crop, ER_IMAGE_COLORMODEL_UNK to use the color model of the source image.
+    \param  crop              ERImage structure to be allocated and filled with the crop, to be freed by erImageFree().
+
+    \return 0 - The crop was successfully generated, other - Error code.
+
+    \see    lpmRunDet, lpmFreeDetResult
+*/
+ER_FUNCTION_PREFIX int lpmGetDetectionCrop(LPMState lpm_state, const LpmDetResult *detection_result, int detection_index, ERImage image, unsigned int width, unsigned int height, ERImageColorModel color_model, ERImage *crop);
+
+
+/*! \fn LpmDetResult *lpmRunDetBatch(LPMState lpm_state, int module_index, const ERImage *images, const LpmBoundingBox *bounding_boxes, int num_images)
+
+    \brief  Runs license/ADR plate detection on several images at once (e.g. frames from multiple cameras).
+
+    Images are grouped by their geometry only, i.e. size and color model, and processed by the detector in
+    batches of at most LpmModuleConfig_extension2::det_max_batch_size images. The detection area of each image is
+    applied within the batch, so images of one geometry with different detection areas (e.g. cameras with their own
+    areas of interest) share a batch and each result contains only the detections within the area of its image.
+    Images of different sizes or color models can be mixed in one call, they are just batched separately.
+
+    \param  lpm_state       The LPM state created by lpmInit() function.
+    \param  module_index    Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  images          Array of num_images ERImage structures containing the images for detection.
+    \param  bounding_boxes  Array of num_images bounding boxes of the detection areas, one for each image.
+    \param  num_images      Number of images to process.
+
+    \return NULL - Error during computation occurred, other - Array of num_images LpmDetResult structures,
+            the i-th result belongs to the i-th image.
+
+    \see    lpmInit, lpmLoadModule, lpmFreeDetResultBatch, lpmRunDet
+*/
+ER_FUNCTION_PREFIX LpmDetResult *lpmRunDetBatch(LPMState lpm_state, int module_index, const ERImage *images, const LpmBoundingBox *bounding_boxes, int num_images);
+
+
+/*! \fn LpmDetResult *lpmRunDetBatchEx(LPMState lpm_state, int module_index, const ERImage *images, const LpmDetParams *params, int num_images)
+
+    \brief  Runs license/ADR plate detection on several images at once with additional per-image parameters.
+
+    The images are grouped into batches by geometry as by lpmRunDetBatch(), images with different view profiles
+    are batched separately since they are scanned at different scales. The other parameters (detection areas,
+    masks, motion gates, pyramids) are applied to each image within its batch and never split a batch.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  images        Array of num_images ERImage structures containing the images for detection.
+    \param  params        Array of num_images detection parameters, one for each image, or NULL to detect on the whole images.
+    \param  num_images    Number of images to process.
+
+    \return NULL - Error during computation occurred, other - Array of num_images LpmDetResult structures,
+            the i-th result belongs to the i-th image. The array is freed by lpmFreeDetResultBatch().
+
+    \see    lpmRunDetBatch, lpmRunDetEx, lpmFreeDetResultBatch
+*/
+ER_FUNCTION_PREFIX LpmDetResult *lpmRunDetBatchEx(LPMState lpm_state, int module_index, const ERImage *images, const LpmDetParams *params, int num_images);
+
+
+/*! \fn void lpmFreeDetResultBatch(LPMState lpm_state, LpmDetResult *detection_results, int num_results)
+
+    \brief  Frees the array of detection result structures generated by lpmRunDetBatch().
+
+    \param  lpm_state          The LPM state created by lpmInit() function.
+    \param  detection_results  Pointer to the array of detection result structures to be freed.
+    \param  num_results        Number of structures in the array, i.e. num_images passed to lpmRunDetBatch().
+
+    \see    lpmInit, lpmLoadModule, lpmRunDetBatch
+*/
+ER_FUNCTION_PREFIX void lpmFreeDetResultBatch(LPMState lpm_state, LpmDetResult *detection_results, int num_results);
+
 /*! @} */ 
 
 
@@ -281,10 +763,15 @@ ER_FUNCTION_PREFIX void lpmFreeDetResult(LPMState lpm_state, LpmDetResult *detec
 
     \param  lpm_state           The LPM state created by lpmInit() function.
     \param  module_index        Index of the LPM module to use. Note that module index and module ID are two different things.
-    \param  image               ERImage structure containing the input image.
+    \param  image               ERImage structure containing the input image. Besides BGR, BGRA and GRAY images, full-frame
+                                YCbCr 4:2:0 (I420) and NV12 images are accepted without conversion; the chroma planes must follow the luma
+                                rows as described in er_image.h (IMAGE DATA TYPES, also for a chroma plane at an aligned offset).
     \param  detection_position  The 4-point position of the detection.
     \param  detection_label     The detection label specifying the type of detection; can be obtained from the LpmDetection structure if using the lpmRunDet() function.
 
+    \note   The image rows are accessed through data and step only, so views created by erImageInitView()
+            (including padded and negative-step buffers) can be passed without row_data.
+
     \return NULL - Error during computation occurred, other - LpmOcrResult structure with all detections.
 
     \see    lpmInit, lpmLoadModule, lpmFreeOcrResult, lpmRunDet
@@ -303,77 +790,767 @@ ER_FUNCTION_PREFIX LpmOcrResult *lpmRunOcr(LPMState lpm_state, int module_index,
 */  
 ER_FUNCTION_PREFIX void lpmFreeOcrResult(LPMState lpm_state, LpmOcrResult *ocr_result);
 
+
+/*! \fn LpmOcrResult *lpmRunOcrPyramid(LPMState lpm_state, int module_index, const ERImagePyramid *pyramid, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label)
+
+    \brief  Runs OCR on the image represented by a pyramid, the plate is sampled from the best fitting pyramid level.
+
+    \param  lpm_state           The LPM state created by lpmInit() function.
+    \param  module_index        Index of the LPM module to use. Note that module index and module ID are two different things.
+    \param  pyramid             Pyramid of the input image built by erImagePyramidBuild().
+    \param  detection_position  The 4-point position of the detection in the source image coordinates.
+    \param  detection_label     The detection label specifying the type of detection.
+
+    \return NULL - Error during computation occurred, other - LpmOcrResult structure.
+
+    \see    lpmRunOcr, lpmGetPyramidScales, lpmFreeOcrResult
+*/
+ER_FUNCTION_PREFIX LpmOcrResult *lpmRunOcrPyramid(LPMState lpm_state, int module_index, const ERImagePyramid *pyramid, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label);
+
+
+/*! \fn LpmOcrResult *lpmRunOcrBatch(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *detection_positions, const LpmDetectionLabel *detection_labels, int num_detections)
+
+    \brief  Runs OCR on several detections of the same image at once.
+
+    All the crops are sampled from the image first and then processed by the OCR in batches of at most
+    LpmModuleConfig_extension2::ocr_max_batch_size crops, which is considerably faster than calling
+    lpmRunOcr() for each detection separately.
+
+    \param  lpm_state           The LPM state created by lpmInit() function.
+    \param  module_index        Index of the LPM module to use. Note that module index and module ID are two different things.
+    \param  image               ERImage structure containing the input image.
+    \param  detection_positions Array of num_detections 4-point positions of the detections.
+    \param  detection_labels    Array of num_detections detection labels, one for each position; can be obtained from the LpmDetection structures if using the lpmRunDet() function.
+    \param  num_detections      Number of detections to process.
+
+    \return NULL - Error during computation occurred, other - Array of num_detections LpmOcrResult structures,
+            the i-th result belongs to the i-th detection position.
+
+    \see    lpmInit, lpmLoadModule, lpmFreeOcrResultBatch, lpmRunOcr, lpmRunDet
+*/
+ER_FUNCTION_PREFIX LpmOcrResult *lpmRunOcrBatch(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *detection_positions, const LpmDetectionLabel *detection_labels, int num_detections);
+
+
+/*! \fn void lpmFreeOcrResultBatch(LPMState lpm_state, LpmOcrResult *ocr_results, int num_results)
+
+    \brief  Frees the array of OCR result structures generated by lpmRunOcrBatch().
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  ocr_results   Pointer to the array of OCR result structures to be freed.
+    \param  num_results   Number of structures in the array, i.e. num_detections passed to lpmRunOcrBatch().
+
+    \see    lpmInit, lpmLoadModule, lpmRunOcrBatch
+*/
+ER_FUNCTION_PREFIX void lpmFreeOcrResultBatch(LPMState lpm_state, LpmOcrResult *ocr_results, int num_results);
+
 /*!  @} */
 
 
 
 /* ======================================================== */
 /*                                                          */
-/*  LPM MODULE HANDLING FUNCTIONS                           */
+/*  LPM DETECTION + OCR FUNCTIONS                           */
 /*                                                          */
 /*                                                          */
 /* ======================================================== */
 
-/*! \defgroup LPMutils  LPM module utils
-@{
+/*! \defgroup LPMDetOcr  Run detection and OCR
+ @{
 */
 
-/*! \fn int lpmGetNumAvlbModules(LPMState lpm_state)
+/*! \fn LpmDetOcrResult *lpmRunDetOcr(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *bounding_box, const LpmDetectionLabel *skip_labels, int num_skip_labels)
 
-    \brief  Gets the number of available LPM modules.
+    \brief  Runs license/ADR plate detection followed by OCR of all detections on the given image.
 
-    \param  lpm_state The LPM state created by lpmInit() function.
+    This is equivalent to calling lpmRunDet() and then lpmRunOcr() for each detection, but the image pyramid,
+    the normalized image buffers and the plate crops built by the detector are reused by the OCR
+    instead of being resampled from the input image again.
 
-    \return -1 - Error during computation occurred, other - Number of LPM modules.
+    \param  lpm_state        The LPM state created by lpmInit() function.
+    \param  module_index     Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  image            ERImage structure containing the image for detection.
+    \param  bounding_box     The bounding box of a detection area.
+    \param  skip_labels      Array of detection labels the OCR is not run on (e.g. LPM_LABEL_VEHICLE), or NULL to run the OCR on all detections.
+    \param  num_skip_labels  Number of labels in the skip_labels array.
 
-    \see    lpmInit
-*/
-ER_FUNCTION_PREFIX int lpmGetNumAvlbModules(LPMState lpm_state);
+    \return NULL - Error during computation occurred, other - LpmDetOcrResult structure with all detections and their OCR results.
 
+    \see    lpmInit, lpmLoadModule, lpmFreeDetOcrResult, lpmRunDet, lpmRunOcr
+*/
+ER_FUNCTION_PREFIX LpmDetOcrResult *lpmRunDetOcr(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *bounding_box, const LpmDetectionLabel *skip_labels, int num_skip_labels);
 
-/*! \fn int lpmGetModuleIndex(LPMState lpm_state, int module_id, int version, int subversion)
 
-    \brief  Gets the LPM module index (handle) from the module ID and its version.
+/*! \fn LpmDetOcrResult *lpmRunDetOcrEx(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params, const LpmDetectionLabel *skip_labels, int num_skip_labels)
 
-    Module indices can be vary with each program execution because they depend
-    on the search order of the LPM module directory.
+    \brief  Runs license/ADR plate detection with additional per-call parameters followed by OCR of all detections.
 
-    \param  lpm_state   The LPM state created by lpmInit() function.
-    \param  module_id   ID of the module.
-    \param  version     Version of the module.
-    \param  subversion  Subversion of the module.
+    The detection runs as lpmRunDetEx(), the OCR of the detections uses the same view profile.
 
-    \note   Set version and subversion to zero to get an index of the latest available module.
+    \param  lpm_state        The LPM state created by lpmInit() function.
+    \param  module_index     Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  image            ERImage structure containing the image for detection.
+    \param  params           Parameters of the detection (detection areas, masks, view profile, ...), or NULL to detect on the whole image.
+    \param  skip_labels      Array of detection labels the OCR is not run on (e.g. LPM_LABEL_VEHICLE), or NULL to run the OCR on all detections.
+    \param  num_skip_labels  Number of labels in the skip_labels array.
 
-    \return -1 - Error during computation occurred, other - Module index.
+    \return NULL - Error during computation occurred, other - LpmDetOcrResult structure with all detections and their OCR results.
 
-    \see    lpmInit, lpmGetModuleInfo
+    \see    lpmRunDetOcr, lpmRunDetEx, lpmFreeDetOcrResult
 */
-ER_FUNCTION_PREFIX int lpmGetModuleIndex(LPMState lpm_state, int module_id, int version, int subversion);
-
-
-/*! \fn int lpmGetModuleIndexByName(LPMState lpm_state, const char *module_name)
+ER_FUNCTION_PREFIX LpmDetOcrResult *lpmRunDetOcrEx(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params, const LpmDetectionLabel *skip_labels, int num_skip_labels);
 
-    \brief  Gets the LPM module index (handle) from the module name.
 
-    Module indices can be vary with each program execution because it depends
-    on the search order of the given module directory.
+/*! \fn void lpmFreeDetOcrResult(LPMState lpm_state, LpmDetOcrResult *det_ocr_result)
 
-    \param  lpm_state    The LPM state created by lpmInit() function.
-    \param  module_name  The name of the given module (see lpmGetModuleInfo()).
+    \brief  Frees the combined result structure generated by lpmRunDetOcr().
 
-    \return -1 - Error during computation occurred, other - Module index.
+    \param  lpm_state       The LPM state created by lpmInit() function.
+    \param  det_ocr_result  Pointer to the combined result structure to be freed.
 
-    \see    lpmInit, lpmGetModuleInfo
+    \see    lpmInit, lpmLoadModule, lpmRunDetOcr
 */
-ER_FUNCTION_PREFIX int lpmGetModuleIndexByName(LPMState lpm_state, const char *module_name);
+ER_FUNCTION_PREFIX void lpmFreeDetOcrResult(LPMState lpm_state, LpmDetOcrResult *det_ocr_result);
 
+/*!  @} */
 
-/*! \fn LpmModuleInfo *lpmGetModuleInfo(LPMState lpm_state, int module_index)
 
-    \brief  Retrieves information about the LPM module.
 
-    \param  lpm_state     The LPM state created by lpmInit() function.
+/* ======================================================== */
+/*                                                          */
+/*  LPM RESULT ARENA FUNCTIONS                              */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMArena  Reusable result buffers
+ @{
+
+    lpmRunDetInto() and lpmRunOcrInto() store the whole result tree (detections, extensions, crops,
+    hypotheses, text lines and strings) in one contiguous block of a caller-owned result arena instead of
+    allocating it on the heap. The block grows only when a result does not fit into it, so reusing the same
+    arena for every frame allocates nothing in the steady state.
+
+    A result stored in an arena stays valid until the next call using the same arena or until the arena is
+    freed; it must not be freed by lpmFreeDetResult() or lpmFreeOcrResult(), nor must its crops be freed by
+    erImageFree(). An arena must not be used by more than one thread at a time.
+*/
+
+/*! \fn LpmResultArena lpmCreateResultArena(LPMState lpm_state, size_t initial_capacity)
+
+    \brief  Creates a result arena.
+
+    \param  lpm_state         The LPM state created by lpmInit() function.
+    \param  initial_capacity  Initial byte size of the arena memory block; it is allocated on the first use if set to 0.
+
+    \return NULL - Error during allocation occurred, other - The result arena.
+
+    \see    lpmFreeResultArena, lpmRunDetInto, lpmRunOcrInto
+*/
+ER_FUNCTION_PREFIX LpmResultArena lpmCreateResultArena(LPMState lpm_state, size_t initial_capacity);
+
+
+/*! \fn void lpmFreeResultArena(LPMState lpm_state, LpmResultArena *arena)
+
+    \brief  Frees the result arena and the result stored in it, and sets the arena to NULL.
+
+    \param  lpm_state  The LPM state created by lpmInit() function.
+    \param  arena      Pointer to the result arena to be freed.
+
+    \see    lpmCreateResultArena
+*/
+ER_FUNCTION_PREFIX void lpmFreeResultArena(LPMState lpm_state, LpmResultArena *arena);
+
+
+/*! \fn size_t lpmGetResultArenaCapacity(LpmResultArena arena)
+
+    \brief  Returns the current byte size of the arena memory block.
+
+    \param  arena  The result arena created by lpmCreateResultArena() function.
+
+    \return The byte size of the arena memory block.
+
+    \see    lpmCreateResultArena
+*/
+ER_FUNCTION_PREFIX size_t lpmGetResultArenaCapacity(LpmResultArena arena);
+
+
+/*! \fn LpmDetResult *lpmRunDetInto(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params, LpmResultArena arena)
+
+    \brief  Runs license/ADR plate detection on the given image and stores the result in the result arena.
+
+    The detection runs as lpmRunDetEx(), so all the per-call parameters (view profile, detection areas, masks,
+    pyramid and motion gate) can be used.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  image         ERImage structure containing the image for detection.
+    \param  params        Parameters of the detection (detection areas, masks, view profile, ...), or NULL to detect on the whole image.
+    \param  arena         The result arena, its previous content is overwritten.
+
+    \return NULL - Error during computation occurred, other - LpmDetResult structure stored in the arena.
+
+    \see    lpmCreateResultArena, lpmRunDetEx
+*/
+ER_FUNCTION_PREFIX LpmDetResult *lpmRunDetInto(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params, LpmResultArena arena);
+
+
+/*! \fn LpmOcrResult *lpmRunOcrInto(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label, LpmResultArena arena)
+
+    \brief  Runs OCR on the given image and stores the result in the result arena.
+
+    \param  lpm_state           The LPM state created by lpmInit() function.
+    \param  module_index        Index of the LPM module to use. Note that module index and module ID are two different things.
+    \param  image               ERImage structure containing the input image.
+    \param  detection_position  The 4-point position of the detection.
+    \param  detection_label     The detection label specifying the type of detection.
+    \param  arena               The result arena, its previous content is overwritten.
+
+    \return NULL - Error during computation occurred, other - LpmOcrResult structure stored in the arena.
+
+    \see    lpmCreateResultArena, lpmRunOcr
+*/
+ER_FUNCTION_PREFIX LpmOcrResult *lpmRunOcrInto(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label, LpmResultArena arena);
+
+/*!  @} */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  LPM WORKER FUNCTIONS                                    */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMWorker  Worker contexts and thread-safety
+ @{
+
+    A loaded module consists of read-only model weights and configuration, which are shared by all
+    computations, and of scratch buffers, which are not. A worker created by lpmCreateWorker() holds only
+    its own scratch buffers, so many workers of a single loaded module cost little memory.
+
+    Thread-safety contract:
+     - lpmInit(), lpmInitEx(), lpmFree(), lpmLoadModule(), lpmLoadModuleSnapshot(), lpmLoadModuleInstance()
+       and lpmFreeModule() must not run concurrently with any other function using the same LPM state.
+     - lpmReloadModule() and lpmSetModuleThreads() can run concurrently with all the functions using the
+       module.
+     - lpmRunDet(), lpmRunOcr() and the other functions taking a module index can be called concurrently
+       from multiple threads, but the calls using the same module are serialized by the engine.
+     - Functions taking different workers run concurrently without any locking. A single worker must not be
+       used by more than one thread at a time. The worker runs the inference on the calling thread only,
+       the det_num_threads and ocr_num_threads thread pools of the module are not used.
+     - The result free functions, lpmGetModuleInfo(), lpmGetModuleFootprint(), lpmGetNumAvlbModules(),
+       lpmGetModuleIndex() and lpmGetModuleIndexByName() can be called from any thread at any time.
+     - All the workers of a module must be freed before the module is freed by lpmFreeModule().
+*/
+
+/*! \fn LpmWorker lpmCreateWorker(LPMState lpm_state, int module_index)
+
+    \brief  Creates a worker context sharing the weights of a loaded LPM module.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of a loaded LPM module. Note that module index and module ID are two different things.
+
+    \return NULL - Error during worker creation occurred, other - The worker context.
+
+    \see    lpmLoadModule, lpmFreeWorker, lpmWarmupWorker, lpmWorkerRunDet, lpmWorkerRunOcr
+*/
+ER_FUNCTION_PREFIX LpmWorker lpmCreateWorker(LPMState lpm_state, int module_index);
+
+
+/*! \fn void lpmFreeWorker(LpmWorker *worker)
+
+    \brief  Frees the worker context created by lpmCreateWorker() and sets it to NULL.
+
+    \param  worker  Pointer to the worker context to be freed.
+
+    \see    lpmCreateWorker
+*/
+ER_FUNCTION_PREFIX void lpmFreeWorker(LpmWorker *worker);
+
+
+/*! \fn int lpmWarmupWorker(LpmWorker worker, const ERImage *sample_image, int iterations, double *warmup_time_ms)
+
+    \brief  Warms up a worker context, so its first lpmWorkerRunDet() and lpmWorkerRunOcr() calls run at the steady-state speed.
+
+    Does for the scratch buffers of the worker what lpmWarmupModule() does for the ones of the module: runs the
+    detector at every scale and the OCR at every input shape, on the calling thread. The compute kernels selected
+    by the module are reused. A worker which is not warmed up allocates its scratch memory during its first calls.
+
+    \param  worker          The worker context created by lpmCreateWorker() function.
+    \param  sample_image    Pointer to an image of the size and color model of the real input, or NULL to use a synthetic image of the module's default size.
+    \param  iterations      Number of warm-up iterations, the module's default is used if set to 0 or negative.
+    \param  warmup_time_ms  Pointer to be filled with the warm-up time in milliseconds, or NULL.
+
+    \return 0 - The worker was successfully warmed up, other - Error code.
+
+    \see    lpmCreateWorker, lpmWarmupModule
+*/
+ER_FUNCTION_PREFIX int lpmWarmupWorker(LpmWorker worker, const ERImage *sample_image, int iterations, double *warmup_time_ms);
+
+
+/*! \fn LpmDetResult *lpmWorkerRunDet(LpmWorker worker, ERImage image, const LpmBoundingBox *bounding_box)
+
+    \brief  Runs license/ADR plate detection on the given image using the worker context.
+
+    \param  worker        The worker context created by lpmCreateWorker() function.
+    \param  image         ERImage structure containing the image for detection.
+    \param  bounding_box  The bounding box of a detection area.
+
+    \return NULL - Error during computation occurred, other - LpmDetResult structure with all detections, to be freed by lpmFreeDetResult().
+
+    \see    lpmCreateWorker, lpmRunDet, lpmFreeDetResult
+*/
+ER_FUNCTION_PREFIX LpmDetResult *lpmWorkerRunDet(LpmWorker worker, ERImage image, const LpmBoundingBox *bounding_box);
+
+
+/*! \fn LpmDetResult *lpmWorkerRunDetEx(LpmWorker worker, ERImage image, const LpmDetParams *params)
+
+    \brief  Runs license/ADR plate detection with additional per-call parameters using the worker context.
+
+    \param  worker  The worker context created by lpmCreateWorker() function.
+    \param  image   ERImage structure containing the image for detection.
+    \param  params  Parameters of the detection, or NULL to behave as lpmWorkerRunDet() on the whole image.
+
+    \return NULL - Error during computation occurred, other - LpmDetResult structure with all detections, to be freed by lpmFreeDetResult().
+
+    \see    lpmCreateWorker, lpmRunDetEx, lpmFreeDetResult
+*/
+ER_FUNCTION_PREFIX LpmDetResult *lpmWorkerRunDetEx(LpmWorker worker, ERImage image, const LpmDetParams *params);
+
+
+/*! \fn LpmOcrResult *lpmWorkerRunOcr(LpmWorker worker, ERImage image, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label)
+
+    \brief  Runs OCR on the given image using the worker context.
+
+    \param  worker              The worker context created by lpmCreateWorker() function.
+    \param  image               ERImage structure containing the input image.
+    \param  detection_position  The 4-point position of the detection.
+    \param  detection_label     The detection label specifying the type of detection.
+
+    \return NULL - Error during computation occurred, other - LpmOcrResult structure, to be freed by lpmFreeOcrResult().
+
+    \see    lpmCreateWorker, lpmRunOcr, lpmFreeOcrResult
+*/
+ER_FUNCTION_PREFIX LpmOcrResult *lpmWorkerRunOcr(LpmWorker worker, ERImage image, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label);
+
+/*!  @} */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  LPM MOTION GATING FUNCTIONS                             */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMMotionGate  Motion gating
+ @{
+
+    A motion gate keeps a low-resolution background model of a single video stream. lpmMotionGateUpdate()
+    compares each frame of the stream with the model, stores the map of the changed blocks and updates the model.
+    The detection calls given the gate in LpmDetParams::motion_gate only read the map of the last updated frame:
+    an empty result is returned immediately if nothing changed, otherwise only the changed blocks are scanned
+    by the detector. Several modules can therefore process the same frame with the same gate (e.g. EU and ADR
+    modules), all of them seeing the changes of that frame.
+
+    The frame passed to the detection must be the frame last passed to lpmMotionGateUpdate(). The detection
+    calls reading a gate can run concurrently, but lpmMotionGateUpdate() and lpmResetMotionGate() must not run
+    concurrently with any other use of the gate.
+*/
+
+/*! \fn LpmMotionGate lpmCreateMotionGate(LPMState lpm_state, const LpmMotionGateConfig *config)
+
+    \brief  Creates a motion gate for a single video stream.
+
+    \param  lpm_state  The LPM state created by lpmInit() function.
+    \param  config     Pointer to optional motion gate configuration. Use NULL for default values.
+
+    \return NULL - Error during creation occurred, other - The motion gate.
+
+    \see    lpmFreeMotionGate, lpmMotionGateUpdate, lpmRunDetEx
+*/
+ER_FUNCTION_PREFIX LpmMotionGate lpmCreateMotionGate(LPMState lpm_state, const LpmMotionGateConfig *config);
+
+
+/*! \fn void lpmFreeMotionGate(LpmMotionGate *motion_gate)
+
+    \brief  Frees the motion gate created by lpmCreateMotionGate() and sets it to NULL.
+
+    \param  motion_gate  Pointer to the motion gate to be freed.
+
+    \see    lpmCreateMotionGate
+*/
+ER_FUNCTION_PREFIX void lpmFreeMotionGate(LpmMotionGate *motion_gate);
+
+
+/*! \fn void lpmResetMotionGate(LpmMotionGate motion_gate)
+
+    \brief  Discards the background model, e.g. after the camera was moved. The next frame is scanned entirely.
+            The counters are kept.
+
+    \param  motion_gate  The motion gate created by lpmCreateMotionGate() function.
+
+    \see    lpmCreateMotionGate
+*/
+ER_FUNCTION_PREFIX void lpmResetMotionGate(LpmMotionGate motion_gate);
+
+
+/*! \fn int lpmMotionGateUpdate(LpmMotionGate motion_gate, ERImage frame)
+
+    \brief  Compares the next frame of the stream with the background model and updates the model.
+
+    Call it once for each frame, before the detection calls using the gate. The first frame after the creation
+    or a reset of the gate is reported as changed entirely.
+
+    \param  motion_gate  The motion gate created by lpmCreateMotionGate() function.
+    \param  frame        ERImage structure containing the frame. It is not referenced after the function returns.
+
+    \return Negative value - Error code, 0 - Nothing changed, the detection of the frame can be skipped entirely,
+            other - Number of changed blocks.
+
+    \see    lpmCreateMotionGate, lpmRunDetEx
+*/
+ER_FUNCTION_PREFIX int lpmMotionGateUpdate(LpmMotionGate motion_gate, ERImage frame);
+
+
+/*! \fn int lpmGetMotionGateStats(LpmMotionGate motion_gate, LpmMotionGateStats *stats)
+
+    \brief  Gets the counters of skipped frames and pixels of the motion gate.
+
+    \param  motion_gate  The motion gate created by lpmCreateMotionGate() function.
+    \param  stats        Structure to be filled with the counters.
+
+    \return 0 - Success, other - Error code.
+
+    \see    lpmCreateMotionGate
+*/
+ER_FUNCTION_PREFIX int lpmGetMotionGateStats(LpmMotionGate motion_gate, LpmMotionGateStats *stats);
+
+/*!  @} */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  LPM TRACKING FUNCTIONS                                  */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMTracking  Video stream tracking
+ @{
+
+    A tracker processes the frames of a single video stream. Detections in consecutive frames are associated
+    into tracks by their cluster_id and position, and the OCR is run on a track only when the track is new,
+    when its detection quality improved (see LpmTrackerConfig::ocr_quality_gain), or while its OCR confidence
+    is low (see LpmTrackerConfig::ocr_confidence_threshold). A finished track carries a single OCR result
+    fused from all its OCR runs.
+
+    A tracker must not be used by more than one thread at a time, and all the trackers of a module must be
+    freed before the module is freed by lpmFreeModule().
+*/
+
+/*! \fn LpmTracker lpmCreateTracker(LPMState lpm_state, int module_index, int view_profile, const LpmTrackerConfig *config)
+
+    \brief  Creates a tracker for a single video stream.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of a loaded LPM module. Note that module index and module ID are two different things.
+    \param  view_profile  Handle of a view profile registered by lpmRegisterViewProfile(), 0 for the camera view parameters given to lpmLoadModule().
+    \param  config        Pointer to optional tracker configuration. Use NULL for default values.
+
+    \return NULL - Error during tracker creation occurred, other - The tracker.
+
+    \see    lpmFreeTracker, lpmTrackerPush, lpmTrackerGetFinishedTracks
+*/
+ER_FUNCTION_PREFIX LpmTracker lpmCreateTracker(LPMState lpm_state, int module_index, int view_profile, const LpmTrackerConfig *config);
+
+
+/*! \fn void lpmFreeTracker(LpmTracker *tracker)
+
+    \brief  Frees the tracker created by lpmCreateTracker() and sets it to NULL. Unfinished tracks are discarded.
+
+    \param  tracker  Pointer to the tracker to be freed.
+
+    \see    lpmCreateTracker, lpmTrackerFlush
+*/
+ER_FUNCTION_PREFIX void lpmFreeTracker(LpmTracker *tracker);
+
+
+/*! \fn int lpmTrackerPush(LpmTracker tracker, ERImage frame, const LpmBoundingBox *bounding_box, double timestamp)
+
+    \brief  Runs the detection on the next frame of the stream and updates the tracks.
+
+    \param  tracker       The tracker created by lpmCreateTracker() function.
+    \param  frame         ERImage structure containing the frame. It is not referenced after the function returns.
+    \param  bounding_box  The bounding box of a detection area, NULL for the whole frame.
+    \param  timestamp     Timestamp of the frame in seconds, must not decrease between calls.
+
+    \return 0 - The frame was successfully processed, other - Error code.
+
+    \see    lpmCreateTracker, lpmTrackerGetFinishedTracks
+*/
+ER_FUNCTION_PREFIX int lpmTrackerPush(LpmTracker tracker, ERImage frame, const LpmBoundingBox *bounding_box, double timestamp);
+
+
+/*! \fn int lpmTrackerPushEx(LpmTracker tracker, ERImage frame, const LpmDetParams *params, double timestamp)
+
+    \brief  Runs the detection with additional per-call parameters on the next frame of the stream and updates the tracks.
+
+    The detection runs as lpmRunDetEx() with the view profile of the tracker (LpmDetParams::view_profile is ignored).
+    With a motion gate (updated by lpmMotionGateUpdate() with this frame), the frames in which nothing changed are
+    not scanned and do not end any track: only the scanned frames count towards LpmTrackerConfig::max_idle_time,
+    so a vehicle standing still keeps its track.
+
+    \param  tracker    The tracker created by lpmCreateTracker() function.
+    \param  frame      ERImage structure containing the frame. It is not referenced after the function returns.
+    \param  params     Parameters of the detection (detection areas, masks, motion gate, ...), or NULL for the whole frame.
+    \param  timestamp  Timestamp of the frame in seconds, must not decrease between calls.
+
+    \return 0 - The frame was successfully processed, other - Error code.
+
+    \see    lpmTrackerPush, lpmRunDetEx, lpmMotionGateUpdate
+*/
+ER_FUNCTION_PREFIX int lpmTrackerPushEx(LpmTracker tracker, ERImage frame, const LpmDetParams *params, double timestamp);
+
+
+/*! \fn int lpmTrackerFlush(LpmTracker tracker)
+
+    \brief  Finishes all active tracks, e.g. at the end of the stream.
+
+    \param  tracker  The tracker created by lpmCreateTracker() function.
+
+    \return 0 - Success, other - Error code.
+
+    \see    lpmTrackerGetFinishedTracks
+*/
+ER_FUNCTION_PREFIX int lpmTrackerFlush(LpmTracker tracker);
+
+
+/*! \fn LpmTrackResult *lpmTrackerGetFinishedTracks(LpmTracker tracker)
+
+    \brief  Returns the tracks finished since the previous call of this function.
+
+    \param  tracker  The tracker created by lpmCreateTracker() function.
+
+    \return NULL - Error occurred, other - LpmTrackResult structure with the finished tracks (possibly none).
+
+    \see    lpmTrackerPush, lpmTrackerFlush, lpmFreeTrackResult
+*/
+ER_FUNCTION_PREFIX LpmTrackResult *lpmTrackerGetFinishedTracks(LpmTracker tracker);
+
+
+/*! \fn void lpmFreeTrackResult(LPMState lpm_state, LpmTrackResult *track_result)
+
+    \brief  Frees the tracking result structure generated by lpmTrackerGetFinishedTracks().
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  track_result  Pointer to the tracking result structure to be freed.
+
+    \see    lpmTrackerGetFinishedTracks
+*/
+ER_FUNCTION_PREFIX void lpmFreeTrackResult(LPMState lpm_state, LpmTrackResult *track_result);
+
+/*!  @} */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  LPM ASYNCHRONOUS PROCESSING FUNCTIONS                   */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMAsync  Asynchronous processing
+ @{
+
+    Requests submitted by lpmSubmitDet() and lpmSubmitOcr() are queued per module and processed in
+    the submission order on the module's detector and OCR threads (see det_num_threads and ocr_num_threads
+    in LpmModuleConfig_extension1), so no additional threads compete with them. The number of queued
+    requests is bounded by LpmModuleConfig_extension2::async_queue_size.
+
+    All the functions of this group can be called concurrently from any thread. The completion callback
+    is called from an engine thread; it should return quickly and it must not call lpmWait(), lpmFreeModule()
+    or lpmFree(). It can chain requests (e.g. OCR of the detections) by lpmSubmitDet() and lpmSubmitOcr(),
+    which never block when called from a completion callback: if the queue is full, they fail immediately
+    with a negative ticket even with async_block_when_full enabled, since the blocked engine thread could be
+    the one which frees the slot. Tickets of requests submitted with a callback are released as soon as the callback returns,
+    other tickets are released when their result is collected by lpmWait(). lpmFreeModule() waits until all
+    requests submitted to the module are finished.
+*/
+
+/*! \fn LpmTicket lpmSubmitDet(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *bounding_box, LpmCompletionCallback callback, void *user_data)
+
+    \brief  Submits license/ADR plate detection on the given image and returns immediately.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  image         ERImage structure containing the image for detection. The image data must stay valid until the request is finished.
+    \param  bounding_box  The bounding box of a detection area, it is copied on submission.
+    \param  callback      Function called when the request is finished, or NULL to collect the result by lpmWait().
+    \param  user_data     Pointer passed to the callback.
+
+    \return Negative value - Error (e.g. full queue with async_block_when_full disabled or when called from a completion callback), other - Ticket of the request.
+
+    \see    lpmPoll, lpmWait, lpmRunDet
+*/
+ER_FUNCTION_PREFIX LpmTicket lpmSubmitDet(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *bounding_box, LpmCompletionCallback callback, void *user_data);
+
+
+/*! \fn LpmTicket lpmSubmitDetEx(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params, LpmCompletionCallback callback, void *user_data)
+
+    \brief  Submits license/ADR plate detection with additional per-call parameters and returns immediately.
+
+    The detection runs as lpmRunDetEx(). The params structure and the arrays it points to (detection areas and
+    scan polygons) are copied on submission; the mask, the pyramid and the motion gate are referenced and must
+    stay valid until the request is finished.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of LPM module to use. Note that module index and module ID are two different things.
+    \param  image         ERImage structure containing the image for detection. The image data must stay valid until the request is finished.
+    \param  params        Parameters of the detection (detection areas, masks, view profile, ...), or NULL to detect on the whole image.
+    \param  callback      Function called when the request is finished, or NULL to collect the result by lpmWait().
+    \param  user_data     Pointer passed to the callback.
+
+    \return Negative value - Error (e.g. full queue with async_block_when_full disabled or when called from a completion callback), other - Ticket of the request.
+
+    \see    lpmSubmitDet, lpmRunDetEx, lpmPoll, lpmWait
+*/
+ER_FUNCTION_PREFIX LpmTicket lpmSubmitDetEx(LPMState lpm_state, int module_index, ERImage image, const LpmDetParams *params, LpmCompletionCallback callback, void *user_data);
+
+
+/*! \fn LpmTicket lpmSubmitOcr(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label, LpmCompletionCallback callback, void *user_data)
+
+    \brief  Submits OCR of a single detection on the given image and returns immediately.
+
+    \param  lpm_state           The LPM state created by lpmInit() function.
+    \param  module_index        Index of the LPM module to use. Note that module index and module ID are two different things.
+    \param  image               ERImage structure containing the input image. The image data must stay valid until the request is finished.
+    \param  detection_position  The 4-point position of the detection, it is copied on submission.
+    \param  detection_label     The detection label specifying the type of detection.
+    \param  callback            Function called when the request is finished, or NULL to collect the result by lpmWait().
+    \param  user_data           Pointer passed to the callback.
+
+    \return Negative value - Error (e.g. full queue with async_block_when_full disabled or when called from a completion callback), other - Ticket of the request.
+
+    \see    lpmPoll, lpmWait, lpmRunOcr
+*/
+ER_FUNCTION_PREFIX LpmTicket lpmSubmitOcr(LPMState lpm_state, int module_index, ERImage image, const LpmBoundingBox *detection_position, LpmDetectionLabel detection_label, LpmCompletionCallback callback, void *user_data);
+
+
+/*! \fn int lpmPoll(LPMState lpm_state, LpmTicket ticket)
+
+    \brief  Checks whether a submitted request is finished without blocking.
+
+    \param  lpm_state  The LPM state created by lpmInit() function.
+    \param  ticket     Ticket returned by lpmSubmitDet() or lpmSubmitOcr().
+
+    \return -1 - Unknown ticket or its result was already collected, 0 - The request is pending, 1 - The request is finished.
+
+    \see    lpmSubmitDet, lpmSubmitOcr, lpmWait
+*/
+ER_FUNCTION_PREFIX int lpmPoll(LPMState lpm_state, LpmTicket ticket);
+
+
+/*! \fn int lpmWait(LPMState lpm_state, LpmTicket ticket, int timeout_ms, LpmAsyncResult *result)
+
+    \brief  Waits until a submitted request is finished and collects its result.
+
+    \param  lpm_state   The LPM state created by lpmInit() function.
+    \param  ticket      Ticket returned by lpmSubmitDet() or lpmSubmitOcr().
+    \param  timeout_ms  Maximal waiting time in milliseconds, negative value to wait without a limit.
+    \param  result      Structure to be filled with the result, or NULL. It is left untouched for requests
+                        submitted with a callback, as their results are passed to the callback.
+
+    \return -1 - Unknown ticket or its result was already collected, 0 - The request is finished, 1 - Timeout expired.
+
+    \see    lpmSubmitDet, lpmSubmitOcr, lpmPoll
+*/
+ER_FUNCTION_PREFIX int lpmWait(LPMState lpm_state, LpmTicket ticket, int timeout_ms, LpmAsyncResult *result);
+
+/*!  @} */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  LPM MODULE HANDLING FUNCTIONS                           */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPMutils  LPM module utils
+@{
+*/
+
+/*! \fn int lpmGetNumAvlbModules(LPMState lpm_state)
+
+    \brief  Gets the number of available LPM modules.
+
+    Module instances loaded by lpmLoadModuleInstance() are not counted.
+
+    \param  lpm_state The LPM state created by lpmInit() function.
+
+    \return -1 - Error during computation occurred, other - Number of LPM modules.
+
+    \see    lpmInit
+*/
+ER_FUNCTION_PREFIX int lpmGetNumAvlbModules(LPMState lpm_state);
+
+
+/*! \fn int lpmGetModuleIndex(LPMState lpm_state, int module_id, int version, int subversion)
+
+    \brief  Gets the LPM module index (handle) from the module ID and its version.
+
+    Module indices can be vary with each program execution because they depend
+    on the search order of the LPM module directory.
+
+    \param  lpm_state   The LPM state created by lpmInit() function.
+    \param  module_id   ID of the module.
+    \param  version     Version of the module.
+    \param  subversion  Subversion of the module.
+
+    \note   Set version and subversion to zero to get an index of the latest available module.
+
+    \return -1 - Error during computation occurred, other - Module index.
+
+    \see    lpmInit, lpmGetModuleInfo
+*/
+ER_FUNCTION_PREFIX int lpmGetModuleIndex(LPMState lpm_state, int module_id, int version, int subversion);
+
+
+/*! \fn int lpmGetModuleIndexByName(LPMState lpm_state, const char *module_name)
+
+    \brief  Gets the LPM module index (handle) from the module name.
+
+    Module indices can be vary with each program execution because it depends
+    on the search order of the given module directory.
+
+    \param  lpm_state    The LPM state created by lpmInit() function.
+    \param  module_name  The name of the given module (see lpmGetModuleInfo()).
+
+    \return -1 - Error during computation occurred, other - Module index.
+
+    \see    lpmInit, lpmGetModuleInfo
+*/
+ER_FUNCTION_PREFIX int lpmGetModuleIndexByName(LPMState lpm_state, const char *module_name);
+
+
+/*! \fn LpmModuleInfo *lpmGetModuleInfo(LPMState lpm_state, int module_index)
+
+    \brief  Retrieves information about the LPM module.
+
+    For a module instance index (see lpmLoadModuleInstance()), the information of the module the instance
+    was loaded from is returned.
+
+    The returned structure is owned by the LPM state and it is never modified or freed before lpmFree(), even when
+    the module is freed or replaced by lpmReloadModule() (the index then reports a new structure), so the pointer
+    can be kept and read from any thread.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
     \param  module_index  Index of the LPM module to use. Note that module index and module ID are two different things.
 
     \return A pointer to the LpmModuleInfo structure or NULL on error (see errno for details).
@@ -383,6 +1560,24 @@ ER_FUNCTION_PREFIX int lpmGetModuleIndexByName(LPMState lpm_state, const char *m
 ER_FUNCTION_PREFIX LpmModuleInfo *lpmGetModuleInfo(LPMState lpm_state, int module_index);
 
 
+/*! \fn int lpmGetModuleFootprint(LPMState lpm_state, int module_index, LpmModuleInfo_extension1 *footprint)
+
+    \brief  Gets the current memory footprint of the weights of a loaded LPM module.
+
+    The resident and shared sizes are measured at the time of the call and stored in the caller's structure,
+    so the function can be called from any thread at any time.
+
+    \param  lpm_state     The LPM state created by lpmInit() function.
+    \param  module_index  Index of a loaded LPM module or module instance.
+    \param  footprint     Structure to be filled with the footprint, its extras field is set to NULL.
+
+    \return 0 - Success, other - Error code (e.g. the module is not loaded).
+
+    \see    lpmGetModuleInfo, lpmLoadModule
+*/
+ER_FUNCTION_PREFIX int lpmGetModuleFootprint(LPMState lpm_state, int module_index, LpmModuleInfo_extension1 *footprint);
+
+
 /*!  @} */
 
 
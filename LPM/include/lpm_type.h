@@ -23,6 +23,8 @@
 #ifndef _LPM_TYPE_H_
 #define _LPM_TYPE_H_
 
+#include <stddef.h>
+
 #include "er_image.h"
 
 
@@ -37,6 +39,18 @@
 
 typedef void *LPMState;
 
+/*! Worker context of a loaded module, see lpmCreateWorker(). */
+typedef void *LpmWorker;
+
+/*! Caller-owned reusable memory block for results, see lpmCreateResultArena(). */
+typedef void *LpmResultArena;
+
+/*! Video stream tracker, see lpmCreateTracker(). */
+typedef void *LpmTracker;
+
+/*! Motion gate of a video stream, see lpmCreateMotionGate(). */
+typedef void *LpmMotionGate;
+
 
 /* ======================================================== */
 /*                                                          */
@@ -102,6 +116,7 @@ typedef struct
 
 #define LPM_EXTENSIONS_v7_3     1
 #define LPM_EXTENSIONS_v7_6     1
+#define LPM_EXTENSIONS_v7_7     1
 
 
 #if defined(WIN32) || defined(WIN64) || defined(WINDOWS)
@@ -218,6 +233,16 @@ typedef struct
 typedef long long LpmPropertyFlags;
 
 
+/*! Configuration of the LPM engine initialization. Unused values must be zero-initialized. */
+typedef struct
+{
+    /*! If non-zero, the modules directory is only enumerated and each module is opened on its first use. */
+    int         lazy_discovery;
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void       *extras;
+} LpmInitConfig;
+
+
 /*! View type */
 typedef enum
 {
@@ -243,6 +268,133 @@ typedef struct
 } LpmCameraViewParams;
 
 
+/*! Expected license plate resolution in a horizontal band of the image */
+typedef struct
+{
+    /*! Top row of the band relative to the image height, in range [0, 1]. */
+    float        top;
+    /*! Bottom row of the band relative to the image height, in range [0, 1]. */
+    float        bottom;
+    /*! Minimal horizontal resolution in the band in number of pixels per meter. */
+    unsigned int min_horizontal_resolution;
+    /*! Maximal horizontal resolution in the band in number of pixels per meter. */
+    unsigned int max_horizontal_resolution;
+} LpmResolutionBand;
+
+
+/*! Perspective-aware map of the expected license plate resolution. Each band of the image is scanned only at the scales
+which can hold a plate there; rows not covered by any band use the resolution range of the camera view parameters. */
+typedef struct
+{
+    /*! Number of bands. */
+    unsigned int       num_bands;
+    /*! Array of bands, they may be as narrow as a single row. */
+    LpmResolutionBand *bands;
+} LpmResolutionMap;
+
+
+/*! Load mode of the module weights */
+typedef enum
+{
+    /*! Weights are read into the private memory of the process. */
+    LPM_WEIGHTS_PRIVATE = 0,
+    /*! Weights are converted once to a page-aligned weights image in LpmModuleConfig_extension2::weights_cache_dir
+    and mapped read-only and shared, so all the processes of the host share a single copy in the page cache. */
+    LPM_WEIGHTS_SHARED = 1
+} LpmWeightsLoadMode;
+
+
+/*! Task run by an LpmExecutor */
+typedef void (*LpmTaskFunction)(void *task_data);
+
+/*! Loop body run by an LpmExecutor for the index range [begin, end) */
+typedef void (*LpmRangeFunction)(void *task_data, int begin, int end);
+
+
+/*! Interface of an external executor (thread pool) running all the parallel work of the engine */
+typedef struct
+{
+    /*! Opaque pointer passed as the first argument of all the callbacks. */
+    void       *context;
+    /*! Schedules the task to run asynchronously and returns 0, or non-zero if it cannot be scheduled. Required. */
+    int       (*submit)(void *context, LpmTaskFunction task, void *task_data);
+    /*! Runs the body over the range [begin, end) split into chunks of at least grain_size indices and returns when all
+    the chunks are finished. It is called from executor tasks as well, so it must not wait idle for other tasks (e.g. the
+    calling thread takes part in the work). If NULL, the engine implements it on top of submit. */
+    void      (*parallel_for)(void *context, int begin, int end, int grain_size, LpmRangeFunction body, void *task_data);
+    /*! Returns the number of threads of the executor, which the engine splits the work for. Required. */
+    int       (*concurrency)(void *context);
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void       *extras;
+} LpmExecutor;
+
+
+/*! Placement of the threads and weights of a module on the CPUs and NUMA nodes of the host.
+Unused values must be zero-initialized, a zero-initialized structure means no placement. */
+typedef struct
+{
+    /*! If non-zero, the weights and scratch buffers of the module are allocated on numa_node (the weights are not
+    shared with other nodes unless share_weights_across_nodes is set), otherwise there is no NUMA placement
+    (first-touch). */
+    int         use_numa_node;
+    /*! NUMA node of the module (used only if use_numa_node is non-zero). If cpus is NULL, the threads of the module
+    are also pinned to the CPUs of this node. */
+    int         numa_node;
+    /*! Array of logical CPU indices the threads of the module are pinned to, NULL for no pinning (or the CPUs of
+    numa_node if use_numa_node is set). The default number of threads is derived from the number of these CPUs. */
+    const int  *cpus;
+    /*! Number of entries in the cpus array. */
+    int         num_cpus;
+    /*! Placement of the weights when use_numa_node is set. By default (zero) the weights are node-local: the module
+    uses the copy held by an instance on numa_node, or gets its own copy there if there is none, and with
+    LPM_WEIGHTS_SHARED the mapped weights image is replicated once per node. If non-zero, the module shares the weights
+    of an instance on any node and gets its own copy on numa_node only if no instance holds them. Ignored if
+    use_numa_node is not set, in which case the weights are always shared with the instances loaded before. */
+    int         share_weights_across_nodes;
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void       *extras;
+} LpmModuleAffinity;
+
+
+/*! Second extension of the configuration for module initialization */
+typedef struct
+{
+    /*! Maximal number of crops processed by the OCR in one batch (see lpmRunOcrBatch()).
+    Uses the module's default batch size if set to 0 or negative. */
+    int         ocr_max_batch_size;
+    /*! Maximal number of images processed by the detector in one batch (see lpmRunDetBatch()).
+    Uses the module's default batch size if set to 0 or negative. */
+    int         det_max_batch_size;
+    /*! Maximal number of requests submitted by lpmSubmitDet() or lpmSubmitOcr() which are queued or being processed at a time.
+    Uses the module's default queue size if set to 0 or negative. */
+    int         async_queue_size;
+    /*! If non-zero, lpmSubmitDet() and lpmSubmitOcr() block until there is a free slot in the full queue,
+    otherwise they fail immediately. Calls from a completion callback never block (see LpmCompletionCallback). */
+    int         async_block_when_full;
+    /*! If non-zero, the detector does not generate LpmDetection::image crops and fills only the affine_mapping;
+    the crops can be generated on demand by lpmGetDetectionCrop(). */
+    int         det_lazy_crops;
+    /*! LpmWeightsLoadMode with values LPM_WEIGHTS_PRIVATE or LPM_WEIGHTS_SHARED. */
+    LpmWeightsLoadMode weights_load_mode;
+    /*! Directory of the shared weights images (used only with LPM_WEIGHTS_SHARED), the module directory if NULL.
+    The directory must be writable when the weights image of the module does not exist yet. The image is written to
+    a temporary file in the directory and renamed atomically, so processes loading the module at the same moment
+    (e.g. several containers sharing the directory) never see a partial image: each of them either maps the existing
+    image, or writes its own and the first rename wins, the others map the winning image and remove their copy. */
+    const char *weights_cache_dir;
+    /*! If non-zero, the weights are placed in huge pages where the system provides them. */
+    int         weights_huge_pages;
+    /*! External executor running all the parallel work of the detector and the OCR, NULL to use the internal thread pools.
+    If set, det_num_threads and ocr_num_threads are ignored and the module creates no threads. The executor must stay valid
+    until the module is freed, and it can be shared by several modules and by the application. */
+    const LpmExecutor *executor;
+    /*! Placement of the module's threads and weights, NULL for no placement. The threads of an executor are not pinned. */
+    const LpmModuleAffinity *affinity;
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void       *extras;
+} LpmModuleConfig_extension2;
+
+
 /*! Extension of the configuration for module initialization */
 typedef struct
 {
@@ -253,7 +405,8 @@ typedef struct
     /*! GPU device identifier (used only when the computation is running on a GPU) for the OCR. */
     int         ocr_gpu_device_id;
     /*! Specifies the number of threads available for the OCR (used only when the computation is running on a CPU).
-    Uses approximately 90% of logical processors if set to 0 or negative. */
+    Uses approximately 90% of the logical processors available to the process if set to 0 or negative, i.e. the CPU
+    affinity mask (sched_getaffinity) limited by the cgroup v1/v2 CPU quota on Linux. See lpmSetModuleThreads(). */
     int         ocr_num_threads;
     /*! If set to 1, the OCR submodule will not be loaded and will not be available. */
     int         disable_ocr;
@@ -264,12 +417,13 @@ typedef struct
     /*! GPU device identifier (used only when the computation of the detector is running on a GPU). */
     int         det_gpu_device_id;
     /*! Specifies number of threads available for the detector (used only when computation runs on CPU).
-    Uses approximately 90% of logical processors if set to 0 or negative. */
+    Uses approximately 90% of the logical processors available to the process if set to 0 or negative, i.e. the CPU
+    affinity mask (sched_getaffinity) limited by the cgroup v1/v2 CPU quota on Linux. See lpmSetModuleThreads(). */
     int         det_num_threads;
     /*! If 1, the detection submodule will not be loaded and available. If set to 0, it has no effect. */
     int         disable_det;
-    /*! General void pointer allocated for future use, must be NULL if not in use. */
-    void       *extras;
+    /*! Extension of the configuration structure, must be NULL if not in use. Used in version 7.7 and higher. */
+    LpmModuleConfig_extension2 *extras;
 } LpmModuleConfig_extension1;
 
 
@@ -285,6 +439,25 @@ typedef struct
 } LpmModuleConfig;
 
 
+/*! Memory footprint of the loaded module, filled by lpmGetModuleFootprint(). The extension of the module info
+returned by lpmGetModuleInfo() holds the same structure with the resident and shared sizes set to zero. */
+typedef struct
+{
+    /*! Load mode of the module weights, see LpmModuleConfig_extension2::weights_load_mode. */
+    LpmWeightsLoadMode  weights_load_mode;
+    /*! Flag if the weights are placed in huge pages. */
+    int                 weights_huge_pages;
+    /*! Total byte size of the weights, zero if the module is not loaded. */
+    unsigned long long  weights_size;
+    /*! Byte size of the weights resident in physical memory at the time of the lpmGetModuleFootprint() call. */
+    unsigned long long  weights_resident_size;
+    /*! Byte size of the resident weights shared with other mappings (processes) at the time of the lpmGetModuleFootprint() call. */
+    unsigned long long  weights_shared_size;
+    /*! General void pointer allocated for future use. */
+    void               *extras;
+} LpmModuleInfo_extension1;
+
+
 /*! Module Info */
 typedef struct
 {
@@ -324,6 +497,8 @@ typedef struct
     LpmPropertyFlags prop;
     /*! Information about the license in the LpmLicenseInfo struct. */
     LpmLicenseInfo  *license_info;
+    /*! Additional module information, NULL if not in use. Used in version 7.7 and higher. */
+    LpmModuleInfo_extension1 *extras;
 } LpmModuleInfo;
 
 /*!
@@ -419,6 +594,26 @@ typedef struct
 } LpmBoundingBox;
 
 
+/*! Point in image coordinates */
+typedef struct
+{
+    /*! Column */
+    float col;
+    /*! Row */
+    float row;
+} LpmPoint;
+
+
+/*! Closed polygon in image coordinates */
+typedef struct
+{
+    /*! Array of polygon vertices in clockwise or counter-clockwise order. */
+    const LpmPoint *points;
+    /*! Number of polygon vertices (at least 3). */
+    int             num_points;
+} LpmPolygon;
+
+
 /*! Data related to a single license plate detection. 
     \see LpmOcrResult */
 typedef struct
@@ -429,7 +624,8 @@ typedef struct
     LpmBoundingBox      position;
     /*! Detection type label. */
     LpmDetectionLabel   label;
-    /*! The image crop of the detection. Please note that generation of this image can be disabled in configuration files. */
+    /*! The image crop of the detection. Please note that generation of this image can be disabled in configuration files
+    or deferred to lpmGetDetectionCrop() by LpmModuleConfig_extension2::det_lazy_crops. */
     ERImage             image;
     /*! Array with affine mapping from plate image coordinates to source image coordinates.
     The array contains the first three rows of the affine transformation matrix (a 3x2 matrix), saved row-wise.
@@ -483,6 +679,75 @@ typedef struct
     LpmDetResult_extension1 *extras;
 } LpmDetResult;
 
+
+/*! Configuration of a motion gate. Unused values must be zero-initialized. */
+typedef struct
+{
+    /*! Sensitivity of the change detection in range (0, 1], higher values detect smaller changes.
+    Uses the default value if set to 0 or negative. */
+    float           sensitivity;
+    /*! Size of the square blocks of the image, in pixels, whose change is evaluated together.
+    Uses the default value if set to 0. */
+    unsigned int    block_size;
+    /*! Width in pixels of the low-resolution background model, the height follows the image aspect ratio.
+    Uses the default value if set to 0. */
+    unsigned int    model_width;
+    /*! Rate in range (0, 1] at which the background model adapts to the current frame.
+    Uses the default value if set to 0 or negative. */
+    float           learning_rate;
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void           *extras;
+} LpmMotionGateConfig;
+
+
+/*! Counters of a motion gate */
+typedef struct
+{
+    /*! Number of frames passed to lpmMotionGateUpdate(). */
+    unsigned long long  num_frames;
+    /*! Number of frames skipped entirely because nothing changed. */
+    unsigned long long  num_frames_skipped;
+    /*! Number of pixels of the detection areas of all the frames. */
+    unsigned long long  num_pixels;
+    /*! Number of pixels which were not scanned because they did not change. */
+    unsigned long long  num_pixels_skipped;
+} LpmMotionGateStats;
+
+
+/*! Parameters of a single detection call, see lpmRunDetEx(), lpmRunDetBatchEx(), lpmRunDetOcrEx(), lpmSubmitDetEx() and
+lpmWorkerRunDetEx(), lpmRunDetInto() and lpmTrackerPushEx(). Unused values must be zero-initialized.
+The scanned area is the intersection of the detection area(s), the scan polygons and the mask, where given. */
+typedef struct
+{
+    /*! The bounding box of a detection area, NULL for the whole image. Ignored if num_rois is positive. */
+    const LpmBoundingBox *bounding_box;
+    /*! Handle of a camera view profile registered by lpmRegisterViewProfile(),
+    0 for the camera view parameters given to lpmLoadModule(). */
+    int                   view_profile;
+    /*! Array of num_rois detection areas (e.g. traffic lanes). Detections found in overlapping areas
+    are merged by non-maximum suppression, so each object is reported once. */
+    const LpmBoundingBox *rois;
+    /*! Number of detection areas in the rois array, 0 to use bounding_box. */
+    int                   num_rois;
+    /*! Array of num_scan_polygons polygons, only pixels inside at least one of them are scanned. */
+    const LpmPolygon     *scan_polygons;
+    /*! Number of polygons in the scan_polygons array, 0 to disable the polygon mask. */
+    int                   num_scan_polygons;
+    /*! Bitmap mask of ER_IMAGE_COLORMODEL_GRAY color model and ER_IMAGE_DATATYPE_UCHAR data type, NULL if not in use.
+    Pixels with zero value are not scanned. The mask is stretched to the image size if their sizes differ,
+    so a low-resolution mask can be used. */
+    const ERImage        *mask;
+    /*! Motion gate of the stream the image belongs to, NULL if not in use. The gate is only read: only the blocks
+    changed in the frame last passed to lpmMotionGateUpdate() are scanned, and an empty result is returned if nothing
+    changed. The image must be that frame. */
+    LpmMotionGate         motion_gate;
+    /*! Pyramid of the image built by erImagePyramidBuild(), NULL if not in use. Its levels are used instead of
+    resampling the image, see lpmGetPyramidScales(). The image passed with the pyramid must be its source image. */
+    const ERImagePyramid *pyramid;
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void                 *extras;
+} LpmDetParams;
+
 /*!
  @} 
  */
@@ -578,6 +843,158 @@ typedef struct
     LpmOcrHypothesis *hypotheses;
 } LpmOcrResult;
 
+
+/*! Combined detection and OCR result structure. Holds all detections and the OCR result of each detection.
+\see LpmDetResult, LpmOcrResult */
+typedef struct
+{
+    /*! Detection result with all detections. */
+    LpmDetResult     *det_result;
+    /*! Array of det_result->num_detections OCR results, the i-th result belongs to the i-th detection.
+    Results of detections skipped by the OCR have zero hypotheses. */
+    LpmOcrResult     *ocr_results;
+    /*! General void pointer allocated for future use. */
+    void             *extras;
+} LpmDetOcrResult;
+
+/*!
+ @} 
+ */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  TRACKING STRUCTURE DEFINITIONS                          */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPM_TYPES_TRACK Tracking types
+ @{
+*/
+
+/*! Configuration of a video stream tracker. Unused values must be zero-initialized. */
+typedef struct
+{
+    /*! Time in seconds after which a track without any new detection is finished.
+    Uses the module's default value if set to 0 or negative. */
+    double                   max_idle_time;
+    /*! The OCR is run again on a track while the confidence of its best OCR hypothesis is lower than this value.
+    Uses the module's default value if set to 0 or negative. */
+    double                   ocr_confidence_threshold;
+    /*! The OCR is run again on a track when the detection quality (confidence and size of the detection) improves
+    by at least this ratio over the detection the OCR was last run on, e.g. 0.2 for 20%.
+    Uses the module's default value if set to 0 or negative. */
+    double                   ocr_quality_gain;
+    /*! Array of detection labels which are tracked but the OCR is not run on, NULL to run the OCR on all tracks. */
+    const LpmDetectionLabel *skip_labels;
+    /*! Number of labels in the skip_labels array. */
+    int                      num_skip_labels;
+    /*! General void pointer allocated for future use, must be NULL if not in use. */
+    void                    *extras;
+} LpmTrackerConfig;
+
+
+/*! Single finished track of an object across video frames */
+typedef struct
+{
+    /*! Unique ID of the track within its tracker, starting at 1. */
+    int                 track_id;
+    /*! Detection type label of the tracked object. */
+    LpmDetectionLabel   label;
+    /*! Cluster ID of the tracked object (see LpmDetection_extension1), -1 if not known. */
+    int                 cluster_id;
+    /*! Timestamp of the first frame the object was detected in. */
+    double              first_timestamp;
+    /*! Timestamp of the last frame the object was detected in. */
+    double              last_timestamp;
+    /*! Number of frames the object was detected in. */
+    int                 num_frames;
+    /*! Number of OCR runs made on the track. */
+    int                 num_ocr_runs;
+    /*! Timestamp of the frame with the best detection of the object. */
+    double              best_timestamp;
+    /*! Confidence of the best detection of the object. */
+    double              best_confidence;
+    /*! Position of the best detection of the object in its frame. */
+    LpmBoundingBox      best_position;
+    /*! OCR result fused from all the OCR runs on the track, NULL if the OCR was not run. */
+    LpmOcrResult       *ocr_result;
+    /*! General void pointer allocated for future use. */
+    void               *extras;
+} LpmTrack;
+
+
+/*! Tracking result structure. Holds an array of finished tracks. */
+typedef struct
+{
+    /*! ID of the used LPM module. */
+    int                 lpm_id;
+    /*! Index of the used LPM module. */
+    int                 lpm_idx;
+    /*! Number of finished tracks. */
+    int                 num_tracks;
+    /*! Array of finished tracks. */
+    LpmTrack           *tracks;
+    /*! General void pointer allocated for future use. */
+    void               *extras;
+} LpmTrackResult;
+
+/*!
+ @} 
+ */
+
+
+
+/* ======================================================== */
+/*                                                          */
+/*  ASYNCHRONOUS PROCESSING STRUCTURE DEFINITIONS           */
+/*                                                          */
+/*                                                          */
+/* ======================================================== */
+
+/*! \defgroup LPM_TYPES_ASYNC Asynchronous processing types
+ @{
+*/
+
+/*! Ticket identifying a request submitted by lpmSubmitDet() or lpmSubmitOcr(). Negative values indicate an error. */
+typedef long long LpmTicket;
+
+
+/*! Type of an asynchronous request */
+typedef enum
+{
+    /*! Detection request submitted by lpmSubmitDet(). */
+    LPM_REQUEST_DET = 0,
+    /*! OCR request submitted by lpmSubmitOcr(). */
+    LPM_REQUEST_OCR = 1
+} LpmRequestType;
+
+
+/*! Result of an asynchronous request */
+typedef struct
+{
+    /*! Ticket of the finished request. */
+    LpmTicket           ticket;
+    /*! Type of the finished request. */
+    LpmRequestType      type;
+    /*! Zero on success, error code otherwise (see lpmGetLastError()). */
+    int                 status;
+    /*! Detection result of an LPM_REQUEST_DET request, NULL otherwise or on error. Must be freed by lpmFreeDetResult(). */
+    LpmDetResult       *det_result;
+    /*! OCR result of an LPM_REQUEST_OCR request, NULL otherwise or on error. Must be freed by lpmFreeOcrResult(). */
+    LpmOcrResult       *ocr_result;
+    /*! General void pointer allocated for future use. */
+    void               *extras;
+} LpmAsyncResult;
+
+
+/*! Callback called by the engine when an asynchronous request is finished.
+The result pointers in the LpmAsyncResult structure are passed to the callee, which is responsible for freeing them.
+lpmSubmitDet() and lpmSubmitOcr() called from the callback never block, they fail on a full queue. */
+typedef void (*LpmCompletionCallback)(LPMState lpm_state, const LpmAsyncResult *result, void *user_data);
+
 /*!
  @} 
  */
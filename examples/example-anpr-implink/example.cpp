@@ -269,6 +269,21 @@ int main(int argc, char *argv[])
         return -1;
     }
 
+#ifdef LPM_EXTENSIONS_v7_7
+    // Optional warm-up from LPMv7.7, so the first image is processed at the steady-state speed.
+    // The first test image is the sample, so the warm-up uses the size and color model of the real input.
+    ERImage warmup_image;
+    if (erImageRead(&warmup_image, TestImageList[0]) == 0)
+    {
+        double warmup_time_ms = 0;
+        if (lpmWarmupModule(lpm_state, module_idx, &warmup_image, 0, &warmup_time_ms) == 0)
+        {
+            printf("Module warmed up in %.1f ms\n", warmup_time_ms);
+        }
+        erImageFree(&warmup_image);
+    }
+#endif
+
 
     //////////////////////////////////////////////////////////////////////////////
     //
@@ -0,0 +1,1523 @@
+///////////////////////////////////////////////////////////
+//                                                       //
+// Copyright (c) 2014-2022 by Eyedea Recognition, s.r.o. //
+//                  ALL RIGHTS RESERVED.                 //
+//                                                       //
+// Author: Eyedea Recognition, s.r.o.                    //
+//                                                       //
+// Contact:                                              //
+//           web: http://www.eyedea.cz                   //
+//           email: info@eyedea.cz                       //
+//                                                       //
+// Consult your license regarding permissions and        //
+// restrictions.                                         //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////
+//                        LPM SDK                        //
+//        License plate reading library benchmark        //
+///////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <lpm.h>
+#include <er_image.h>
+
+
+// Path to module(s) directory
+#define MODULES_BASE_DIR        "../../modules-v7/"
+
+#ifdef _WIN32 // Windows paths
+
+#ifdef _WIN64
+#define MODULES_DIR             MODULES_BASE_DIR "x64/"
+#else
+#define MODULES_DIR             MODULES_BASE_DIR "Win32/"
+#endif
+
+#else // Linux paths
+
+#ifdef __aarch64__
+#define MODULES_DIR             MODULES_BASE_DIR "aarch64/"
+#else
+#define MODULES_DIR             MODULES_BASE_DIR "x86_64/"
+#endif
+
+#endif
+
+#define IMAGES_DIR              "../example-anpr-implink/images/"
+
+#define NUM_IMG 10
+const char TestImageList[NUM_IMG][LPM_MAX_PATH_LEN] = {
+    IMAGES_DIR "img_1.jpg",
+    IMAGES_DIR "img_2.jpg",
+    IMAGES_DIR "img_3.jpg",
+    IMAGES_DIR "img_4.jpg",
+    IMAGES_DIR "img_5.jpg",
+    IMAGES_DIR "img_6.jpg",
+    IMAGES_DIR "img_7.jpg",
+    IMAGES_DIR "img_8.jpg",
+    IMAGES_DIR "img_9.jpg",
+    IMAGES_DIR "img_10.jpg",
+};
+
+// Number of timed repetitions of each measurement
+#define NUM_ITERATIONS          20
+
+
+// Returns the time elapsed since start in milliseconds
+static double elapsedMs(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+// Returns a bounding box covering the whole image
+static LpmBoundingBox wholeImage(const ERImage &image)
+{
+    LpmBoundingBox bb;
+    memset(&bb, 0, sizeof(bb));
+    bb.top_left_col = 0;
+    bb.top_left_row = 0;
+    bb.bot_right_col = (float)image.width - 1;
+    bb.bot_right_row = (float)image.height - 1;
+    return bb;
+}
+
+
+// Tolerances of the confidences and positions compared with a reference result
+#define CONFIDENCE_TOLERANCE    1e-4
+#define POSITION_TOLERANCE      1e-2f
+
+static bool samePosition(const LpmBoundingBox &a, const LpmBoundingBox &b)
+{
+    const float *a_coords = &a.top_left_col;
+    const float *b_coords = &b.top_left_col;
+    for (int i = 0; i < 8; i++)
+    {
+        if (fabsf(a_coords[i] - b_coords[i]) > POSITION_TOLERANCE)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameDetResult(const LpmDetResult *a, const LpmDetResult *b)
+{
+    if (a == NULL || b == NULL || a->num_detections != b->num_detections)
+    {
+        return false;
+    }
+    for (int i = 0; i < a->num_detections; i++)
+    {
+        const LpmDetection &a_det = a->detections[i];
+        const LpmDetection &b_det = b->detections[i];
+        if (a_det.label != b_det.label || fabs(a_det.confidence - b_det.confidence) > CONFIDENCE_TOLERANCE ||
+            !samePosition(a_det.position, b_det.position))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameOcrResult(const LpmOcrResult *a, const LpmOcrResult *b)
+{
+    if (a == NULL || b == NULL || a->num_hypotheses != b->num_hypotheses)
+    {
+        return false;
+    }
+    for (unsigned int h = 0; h < a->num_hypotheses; h++)
+    {
+        const LpmOcrHypothesis &a_hyp = a->hypotheses[h];
+        const LpmOcrHypothesis &b_hyp = b->hypotheses[h];
+        if (fabs(a_hyp.confidence - b_hyp.confidence) > CONFIDENCE_TOLERANCE || a_hyp.num_lines != b_hyp.num_lines)
+        {
+            return false;
+        }
+        for (unsigned int l = 0; l < a_hyp.num_lines; l++)
+        {
+            const LpmTextLine &a_line = a_hyp.text_lines[l];
+            const LpmTextLine &b_line = b_hyp.text_lines[l];
+            if (a_line.length != b_line.length ||
+                memcmp(a_line.characters, b_line.characters, a_line.length * sizeof(int)) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Detection batching: frames/sec of lpmRunDetBatch for batch sizes 1/4/8/16
+//
+static int benchmarkDetBatch(LPMState lpm_state, int module_idx, const std::vector<ERImage> &images)
+{
+    const int batch_sizes[] = { 1, 4, 8, 16 };
+
+    printf("Detection batching (%d iterations):\n", NUM_ITERATIONS);
+    for (size_t b = 0; b < sizeof(batch_sizes) / sizeof(batch_sizes[0]); b++)
+    {
+        int batch_size = batch_sizes[b];
+
+        // Simulate frames of batch_size cameras of the same geometry by copies of one test image,
+        // a different one in each iteration; images of different geometry would be split into sub-batches.
+        // Every camera has its own detection area, which must not split the batch: the c-th camera
+        // skips the top c % 4 eighths of the frame.
+        std::vector<std::vector<ERImage> > batches;
+        std::vector<std::vector<LpmBoundingBox> > bbs;
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            batches.push_back(std::vector<ERImage>(batch_size, images[i]));
+            bbs.push_back(std::vector<LpmBoundingBox>(batch_size, wholeImage(images[i])));
+            for (int c = 0; c < batch_size; c++)
+            {
+                bbs[i][c].top_left_row = (float)((c % 4) * images[i].height / 8);
+            }
+        }
+
+        // Warm-up run which is not measured
+        LpmDetResult *det_results = lpmRunDetBatch(lpm_state, module_idx, batches[0].data(), bbs[0].data(), batch_size);
+        if (det_results == NULL)
+        {
+            printf("lpmRunDetBatch failed, code %d.\n", lpmGetLastError());
+            return -1;
+        }
+        lpmFreeDetResultBatch(lpm_state, det_results, batch_size);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int it = 0; it < NUM_ITERATIONS; it++)
+        {
+            size_t i = it % images.size();
+            det_results = lpmRunDetBatch(lpm_state, module_idx, batches[i].data(), bbs[i].data(), batch_size);
+            if (det_results == NULL)
+            {
+                printf("lpmRunDetBatch failed, code %d.\n", lpmGetLastError());
+                return -1;
+            }
+            lpmFreeDetResultBatch(lpm_state, det_results, batch_size);
+        }
+        double total_ms = elapsedMs(start);
+
+        printf("  - batch %2d: %8.2f frames/s, %8.2f ms/batch\n", batch_size,
+            1000.0 * NUM_ITERATIONS * batch_size / total_ms, total_ms / NUM_ITERATIONS);
+    }
+
+    return 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Fused detection + OCR: per-frame latency of lpmRunDetOcr compared with
+// lpmRunDet followed by lpmRunOcr for each detection; the fused results are
+// checked against the two-step ones
+//
+static void freeTwoStepResults(LPMState lpm_state, LpmDetResult *det_result, std::vector<LpmOcrResult *> &ocr_results)
+{
+    for (size_t j = 0; j < ocr_results.size(); j++)
+    {
+        if (ocr_results[j] != NULL)
+        {
+            lpmFreeOcrResult(lpm_state, ocr_results[j]);
+        }
+    }
+    lpmFreeDetResult(lpm_state, det_result);
+}
+
+static int benchmarkDetOcr(LPMState lpm_state, int module_idx, const std::vector<ERImage> &images)
+{
+    // The OCR is not run on vehicle detections in both paths
+    const LpmDetectionLabel skip_labels[] = { LPM_LABEL_VEHICLE, LPM_LABEL_VEHICLE_FRONT, LPM_LABEL_VEHICLE_REAR,
+        LPM_LABEL_VEHICLE_WINDSHIELD, LPM_LABEL_VEHICLE_WHEEL };
+    const int num_skip_labels = sizeof(skip_labels) / sizeof(skip_labels[0]);
+
+    double two_step_ms = 0;
+    double fused_ms = 0;
+    for (int it = 0; it < NUM_ITERATIONS; it++)
+    {
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            LpmBoundingBox bb = wholeImage(images[i]);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            LpmDetResult *det_result = lpmRunDet(lpm_state, module_idx, images[i], &bb);
+            if (det_result == NULL)
+            {
+                printf("lpmRunDet failed, code %d.\n", lpmGetLastError());
+                return -1;
+            }
+            std::vector<LpmOcrResult *> ocr_results(det_result->num_detections, (LpmOcrResult *)NULL);
+            for (int j = 0; j < det_result->num_detections; j++)
+            {
+                LpmDetection &detection = det_result->detections[j];
+                bool skip = false;
+                for (int k = 0; k < num_skip_labels; k++)
+                {
+                    skip = skip || detection.label == skip_labels[k];
+                }
+                if (!skip)
+                {
+                    ocr_results[j] = lpmRunOcr(lpm_state, module_idx, images[i], &(detection.position), detection.label);
+                    if (ocr_results[j] == NULL)
+                    {
+                        printf("lpmRunOcr failed, code %d.\n", lpmGetLastError());
+                        freeTwoStepResults(lpm_state, det_result, ocr_results);
+                        return -1;
+                    }
+                }
+            }
+            two_step_ms += elapsedMs(start);
+
+            start = std::chrono::steady_clock::now();
+            LpmDetOcrResult *det_ocr_result = lpmRunDetOcr(lpm_state, module_idx, images[i], &bb, skip_labels, num_skip_labels);
+            if (det_ocr_result == NULL)
+            {
+                printf("lpmRunDetOcr failed, code %d.\n", lpmGetLastError());
+                freeTwoStepResults(lpm_state, det_result, ocr_results);
+                return -1;
+            }
+            fused_ms += elapsedMs(start);
+
+            // Both paths must produce the same detections and the same OCR result of each detection
+            bool same = sameDetResult(det_ocr_result->det_result, det_result);
+            for (int j = 0; same && j < det_result->num_detections; j++)
+            {
+                const LpmOcrResult &fused_ocr = det_ocr_result->ocr_results[j];
+                same = ocr_results[j] != NULL ? sameOcrResult(&fused_ocr, ocr_results[j]) : fused_ocr.num_hypotheses == 0;
+            }
+            lpmFreeDetOcrResult(lpm_state, det_ocr_result);
+            freeTwoStepResults(lpm_state, det_result, ocr_results);
+            if (!same)
+            {
+                printf("lpmRunDetOcr result of image %d differs from lpmRunDet + lpmRunOcr.\n", (int)i);
+                return -1;
+            }
+        }
+    }
+
+    int num_frames = NUM_ITERATIONS * (int)images.size();
+    printf("Detection + OCR latency (%d frames):\n", num_frames);
+    printf("  - lpmRunDet + lpmRunOcr: %8.2f ms/frame\n", two_step_ms / num_frames);
+    printf("  - lpmRunDetOcr         : %8.2f ms/frame\n", fused_ms / num_frames);
+
+    return 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Concurrent workers: one worker per hardware thread, all sharing the weights
+// of one loaded module and running lpmWorkerRunDet and lpmWorkerRunOcr; every
+// result is checked against lpmRunDet and lpmRunOcr
+//
+static int benchmarkWorkers(LPMState lpm_state, int module_idx, const std::vector<ERImage> &images)
+{
+    int num_workers = (int)std::thread::hardware_concurrency();
+    if (num_workers < 1)
+    {
+        num_workers = 1;
+    }
+
+    // Reference detections of each image and OCR of each of its detections
+    std::vector<LpmDetResult *> det_references;
+    std::vector<std::vector<LpmOcrResult *> > ocr_references;
+    bool references_ok = true;
+    for (size_t i = 0; i < images.size() && references_ok; i++)
+    {
+        LpmBoundingBox bb = wholeImage(images[i]);
+        LpmDetResult *det_result = lpmRunDet(lpm_state, module_idx, images[i], &bb);
+        if (det_result == NULL)
+        {
+            printf("lpmRunDet failed, code %d.\n", lpmGetLastError());
+            references_ok = false;
+            break;
+        }
+        det_references.push_back(det_result);
+        ocr_references.push_back(std::vector<LpmOcrResult *>());
+        for (int d = 0; d < det_result->num_detections; d++)
+        {
+            const LpmDetection &det = det_result->detections[d];
+            LpmOcrResult *ocr_result = lpmRunOcr(lpm_state, module_idx, images[i], &det.position, det.label);
+            if (ocr_result == NULL)
+            {
+                printf("lpmRunOcr failed, code %d.\n", lpmGetLastError());
+                references_ok = false;
+                break;
+            }
+            ocr_references.back().push_back(ocr_result);
+        }
+    }
+
+    std::vector<LpmWorker> workers;
+    for (int w = 0; w < num_workers && references_ok; w++)
+    {
+        LpmWorker worker = lpmCreateWorker(lpm_state, module_idx);
+        if (worker == NULL)
+        {
+            printf("lpmCreateWorker failed, code %d.\n", lpmGetLastError());
+            break;
+        }
+        workers.push_back(worker);
+        // The scratch buffers of every worker are its own, so the module warm-up does not cover them
+        if (lpmWarmupWorker(worker, &images[0], 0, NULL) != 0)
+        {
+            printf("lpmWarmupWorker failed, code %d.\n", lpmGetLastError());
+            references_ok = false;
+        }
+    }
+
+    std::atomic<int> num_det_failures(0);
+    std::atomic<int> num_ocr_failures(0);
+    std::atomic<int> num_ocr_runs(0);
+    std::vector<std::thread> threads;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t w = 0; w < workers.size(); w++)
+    {
+        LpmWorker worker = workers[w];
+        threads.push_back(std::thread([&, worker]()
+        {
+            for (int it = 0; it < NUM_ITERATIONS; it++)
+            {
+                for (size_t i = 0; i < images.size(); i++)
+                {
+                    LpmBoundingBox bb = wholeImage(images[i]);
+                    LpmDetResult *det_result = lpmWorkerRunDet(worker, images[i], &bb);
+                    if (!sameDetResult(det_result, det_references[i]))
+                    {
+                        num_det_failures++;
+                    }
+                    if (det_result != NULL)
+                    {
+                        lpmFreeDetResult(lpm_state, det_result);
+                    }
+
+                    // The OCR runs on the reference positions, so its results are comparable even after a detection failure
+                    for (size_t d = 0; d < ocr_references[i].size(); d++)
+                    {
+                        const LpmDetection &det = det_references[i]->detections[d];
+                        LpmOcrResult *ocr_result = lpmWorkerRunOcr(worker, images[i], &det.position, det.label);
+                        num_ocr_runs++;
+                        if (!sameOcrResult(ocr_result, ocr_references[i][d]))
+                        {
+                            num_ocr_failures++;
+                        }
+                        if (ocr_result != NULL)
+                        {
+                            lpmFreeOcrResult(lpm_state, ocr_result);
+                        }
+                    }
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    double total_ms = elapsedMs(start);
+
+    for (size_t w = 0; w < workers.size(); w++)
+    {
+        lpmFreeWorker(&workers[w]);
+    }
+    for (size_t i = 0; i < det_references.size(); i++)
+    {
+        for (size_t d = 0; d < ocr_references[i].size(); d++)
+        {
+            lpmFreeOcrResult(lpm_state, ocr_references[i][d]);
+        }
+        lpmFreeDetResult(lpm_state, det_references[i]);
+    }
+    if (!references_ok)
+    {
+        return -1;
+    }
+
+    int num_frames = NUM_ITERATIONS * (int)images.size() * (int)workers.size();
+    printf("Concurrent workers (%d workers, %d frames, %d OCR runs):\n", (int)workers.size(), num_frames, num_ocr_runs.load());
+    printf("  - %8.2f frames/s, %d detection results differ from lpmRunDet, %d OCR results differ from lpmRunOcr\n",
+        1000.0 * num_frames / total_ms, num_det_failures.load(), num_ocr_failures.load());
+
+    return (num_det_failures == 0 && num_ocr_failures == 0 && (int)workers.size() == num_workers) ? 0 : -1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Shared executor: tail latency of lpmRunDet while the application keeps
+// its own thread pool busy, with the internal LPM thread pools compared with
+// the application pool plugged in as the LpmExecutor of the module
+//
+
+// Work-stealing application thread pool exposed through the LpmExecutor
+// interface. Every thread owns a deque: tasks submitted from a pool thread go
+// to its own deque and are taken back newest first, idle threads steal the
+// oldest tasks of the other deques. Background tasks are queued at the oldest
+// end, so the engine's tasks never wait behind them in the same deque.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int num_threads)
+    {
+        for (int t = 0; t < num_threads; t++)
+        {
+            queues.push_back(std::unique_ptr<Queue>(new Queue()));
+        }
+        for (int t = 0; t < num_threads; t++)
+        {
+            threads.push_back(std::thread([this, t]() { run(t); }));
+        }
+        memset(&lpm_executor, 0, sizeof(lpm_executor));
+        lpm_executor.context = this;
+        lpm_executor.submit = lpmSubmit;
+        lpm_executor.parallel_for = lpmParallelFor;
+        lpm_executor.concurrency = lpmConcurrency;
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+        for (size_t t = 0; t < threads.size(); t++)
+        {
+            threads[t].join();
+        }
+    }
+
+    void submit(const std::function<void()> &task, bool background = false)
+    {
+        int index = (current_pool == this) ? current_index : (int)(next_queue++ % queues.size());
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            if (background)
+            {
+                queues[index]->tasks.push_front(task);
+            }
+            else
+            {
+                queues[index]->tasks.push_back(task);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            num_pending++;
+        }
+        condition.notify_one();
+    }
+
+    int size() const
+    {
+        return (int)threads.size();
+    }
+
+    const LpmExecutor *executor() const
+    {
+        return &lpm_executor;
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()> > tasks;
+    };
+
+    // Takes the newest task of the own deque or steals the oldest one of another deque
+    bool pop(int index, std::function<void()> &task)
+    {
+        for (size_t i = 0; i < queues.size(); i++)
+        {
+            Queue &queue = *queues[(index + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                if (i == 0)
+                {
+                    task = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                else
+                {
+                    task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                num_pending--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(int index)
+    {
+        current_pool = this;
+        current_index = index;
+        for (;;)
+        {
+            std::function<void()> task;
+            if (pop(index, task))
+            {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            condition.wait(lock, [this]() { return stopped || num_pending > 0; });
+            if (stopped && num_pending == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    static int lpmSubmit(void *context, LpmTaskFunction task, void *task_data)
+    {
+        ((ThreadPool *)context)->submit([task, task_data]() { task(task_data); });
+        return 0;
+    }
+
+    // The calling thread takes chunks too, so nested loops never wait idle
+    static void lpmParallelFor(void *context, int begin, int end, int grain_size, LpmRangeFunction body, void *task_data)
+    {
+        struct Loop
+        {
+            std::atomic<int> next;
+            std::atomic<int> done;
+        };
+        ThreadPool *pool = (ThreadPool *)context;
+        int grain = std::max(grain_size, 1);
+        int num_chunks = (end - begin + grain - 1) / grain;
+        std::shared_ptr<Loop> loop = std::make_shared<Loop>();
+        loop->next = begin;
+        loop->done = 0;
+        std::function<void()> work = [loop, end, grain, body, task_data]()
+        {
+            int chunk_begin;
+            while ((chunk_begin = loop->next.fetch_add(grain)) < end)
+            {
+                int chunk_end = std::min(chunk_begin + grain, end);
+                body(task_data, chunk_begin, chunk_end);
+                loop->done += chunk_end - chunk_begin;
+            }
+        };
+        for (int h = 1; h < std::min(num_chunks, pool->size()); h++)
+        {
+            pool->submit(work);
+        }
+        work();
+        while (loop->done < end - begin)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    static int lpmConcurrency(void *context)
+    {
+        return ((ThreadPool *)context)->size();
+    }
+
+    static thread_local ThreadPool *current_pool;
+    static thread_local int current_index;
+
+    std::vector<std::unique_ptr<Queue> > queues;
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> next_queue{0};
+    std::mutex sleep_mutex;
+    std::condition_variable condition;
+    std::atomic<int> num_pending{0};
+    bool stopped = false;
+    LpmExecutor lpm_executor;
+};
+
+thread_local ThreadPool *ThreadPool::current_pool = NULL;
+thread_local int ThreadPool::current_index = -1;
+
+// Keeps every thread of the pool busy with color conversions until stopped
+class BackgroundLoad
+{
+public:
+    BackgroundLoad(ThreadPool &pool, const std::vector<ERImage> &images) : pool(pool), images(images)
+    {
+        for (int t = 0; t < pool.size(); t++)
+        {
+            num_running++;
+            pool.submit([this, t]() { convert(t); }, true);
+        }
+    }
+
+    ~BackgroundLoad()
+    {
+        stopped = true;
+        while (num_running > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    void convert(int i)
+    {
+        ERImage gray;
+        memset(&gray, 0, sizeof(gray));
+        if (erImageConvert(&images[i % images.size()], &gray, ER_IMAGE_COLORMODEL_GRAY) == 0)
+        {
+            erImageFree(&gray);
+        }
+        if (stopped)
+        {
+            num_running--;
+            return;
+        }
+        pool.submit([this, i]() { convert(i + 1); }, true);
+    }
+
+    ThreadPool &pool;
+    const std::vector<ERImage> &images;
+    std::atomic<bool> stopped{false};
+    std::atomic<int> num_running{0};
+};
+
+// Measures the lpmRunDet latency percentiles under the background load
+static int measureDetLatency(LPMState lpm_state, int module_idx, const std::vector<ERImage> &images, ThreadPool &pool, const char *label)
+{
+    std::vector<double> latencies;
+    BackgroundLoad background_load(pool, images);
+    for (int it = 0; it < NUM_ITERATIONS; it++)
+    {
+        for (size_t i = 0; i < images.size(); i++)
+        {
+            LpmBoundingBox bb = wholeImage(images[i]);
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            LpmDetResult *det_result = lpmRunDet(lpm_state, module_idx, images[i], &bb);
+            latencies.push_back(elapsedMs(start));
+            if (det_result == NULL)
+            {
+                printf("lpmRunDet failed, code %d.\n", lpmGetLastError());
+                return -1;
+            }
+            lpmFreeDetResult(lpm_state, det_result);
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    printf("  - %-22s: p50 %8.2f ms, p99 %8.2f ms, max %8.2f ms\n", label,
+        latencies[latencies.size() / 2], latencies[(latencies.size() * 99) / 100], latencies.back());
+
+    return 0;
+}
+
+// The pool must outlive the module, which keeps using it until lpmFreeModule
+static int benchmarkExecutor(LPMState lpm_state, int module_idx, const std::vector<ERImage> &images, const LpmModuleConfig &module_config, ThreadPool &pool)
+{
+    printf("Detection latency under application load (%d pool threads, %d frames):\n", pool.size(), NUM_ITERATIONS * (int)images.size());
+    if (measureDetLatency(lpm_state, module_idx, images, pool, "internal thread pools") != 0)
+    {
+        return -1;
+    }
+
+    // Reload the same module running on the application pool
+    LpmModuleConfig_extension1 config_extension1 = *module_config.extras;
+    LpmModuleConfig_extension2 config_extension2 = *config_extension1.extras;
+    LpmModuleConfig config = module_config;
+    config_extension2.executor = pool.executor();
+    config_extension1.extras = &config_extension2;
+    config.extras = &config_extension1;
+
+    int ret_code;
+    if ((ret_code = lpmReloadModule(lpm_state, module_idx, module_idx, NULL, NULL, &config)) != 0)
+    {
+        printf("lpmReloadModule failed, code %d.\n", ret_code);
+        return -1;
+    }
+
+    return measureDetLatency(lpm_state, module_idx, images, pool, "shared LpmExecutor");
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Warm-up: latency of the first lpmRunDet and lpmWorkerRunDet call after
+// lpmWarmupModule and lpmWarmupWorker compared with the steady-state median;
+// the first call must be within WARMUP_TOLERANCE of the median
+//
+#define WARMUP_TOLERANCE        0.10
+
+typedef std::function<LpmDetResult *(const ERImage &, const LpmBoundingBox *)> DetFunction;
+
+// Times the first call of det and the median of NUM_ITERATIONS further calls on the sample image,
+// returns 0 if the first call is within the tolerance
+static int measureFirstCall(LPMState lpm_state, const ERImage &sample, DetFunction det, const char *label)
+{
+    LpmBoundingBox bb = wholeImage(sample);
+    std::vector<double> latencies;
+    for (int it = 0; it <= NUM_ITERATIONS; it++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        LpmDetResult *det_result = det(sample, &bb);
+        latencies.push_back(elapsedMs(start));
+        if (det_result == NULL)
+        {
+            printf("%s failed, code %d.\n", label, lpmGetLastError());
+            return 1;
+        }
+        lpmFreeDetResult(lpm_state, det_result);
+    }
+
+    double first_ms = latencies[0];
+    std::sort(latencies.begin() + 1, latencies.end());
+    double median_ms = latencies[1 + NUM_ITERATIONS / 2];
+    bool within = first_ms <= (1.0 + WARMUP_TOLERANCE) * median_ms;
+    printf("  - %-15s: first call %8.2f ms, median %8.2f ms, ratio %5.2f%s\n", label, first_ms, median_ms,
+        first_ms / median_ms, within ? "" : ", FAILED");
+    return within ? 0 : 1;
+}
+
+// Must run on a freshly loaded module, before any other detection or OCR call
+static int benchmarkWarmup(LPMState lpm_state, int module_idx, const std::vector<ERImage> &images)
+{
+    const ERImage &sample = images[0];
+
+    double warmup_ms = 0;
+    if (lpmWarmupModule(lpm_state, module_idx, &sample, 0, &warmup_ms) != 0)
+    {
+        printf("lpmWarmupModule failed, code %d.\n", lpmGetLastError());
+        return -1;
+    }
+    printf("Module warmed up in %.1f ms\n", warmup_ms);
+
+    LpmWorker worker = lpmCreateWorker(lpm_state, module_idx);
+    if (worker == NULL)
+    {
+        printf("lpmCreateWorker failed, code %d.\n", lpmGetLastError());
+        return -1;
+    }
+    if (lpmWarmupWorker(worker, &sample, 0, &warmup_ms) != 0)
+    {
+        printf("lpmWarmupWorker failed, code %d.\n", lpmGetLastError());
+        lpmFreeWorker(&worker);
+        return -1;
+    }
+    printf("Worker warmed up in %.1f ms\n", warmup_ms);
+
+    printf("First call after warm-up (tolerance %.0f %% of the median of %d calls):\n", 100 * WARMUP_TOLERANCE, NUM_ITERATIONS);
+    int num_failures = 0;
+    num_failures += measureFirstCall(lpm_state, sample, [&](const ERImage &image, const LpmBoundingBox *bb)
+        { return lpmRunDet(lpm_state, module_idx, image, bb); }, "lpmRunDet");
+    num_failures += measureFirstCall(lpm_state, sample, [&](const ERImage &image, const LpmBoundingBox *bb)
+        { return lpmWorkerRunDet(worker, image, bb); }, "lpmWorkerRunDet");
+
+    lpmFreeWorker(&worker);
+
+    return num_failures == 0 ? 0 : -1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Image decoding: erImageRead compared with erImageDecode from memory
+// at full resolution, with DCT-domain downscaling and with ROI-only decoding
+//
+static int benchmarkDecode()
+{
+    // Load the encoded test images into memory
+    std::vector<std::vector<unsigned char> > buffers;
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        FILE *file = fopen(TestImageList[i], "rb");
+        if (file == NULL)
+        {
+            std::cerr << "Can't load the file: " << TestImageList[i] << std::endl;
+            return -1;
+        }
+        std::vector<unsigned char> buffer;
+        unsigned char chunk[65536];
+        size_t length;
+        while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        {
+            buffer.insert(buffer.end(), chunk, chunk + length);
+        }
+        fclose(file);
+        buffers.push_back(buffer);
+    }
+
+    // Full-resolution image sizes, used for the ROI decoding
+    std::vector<unsigned int> widths;
+    std::vector<unsigned int> heights;
+
+    int num_images = NUM_ITERATIONS * NUM_IMG;
+    printf("Image decoding (%d images):\n", num_images);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int it = 0; it < NUM_ITERATIONS; it++)
+    {
+        for (int i = 0; i < NUM_IMG; i++)
+        {
+            ERImage image;
+            if (erImageRead(&image, TestImageList[i]) != 0)
+            {
+                printf("erImageRead failed: %s\n", erGetErrorLog());
+                return -1;
+            }
+            if (it == 0)
+            {
+                widths.push_back(image.width);
+                heights.push_back(image.height);
+            }
+            erImageFree(&image);
+        }
+    }
+    printf("  - erImageRead           : %8.2f ms/image\n", elapsedMs(start) / num_images);
+
+    const unsigned int scale_denoms[] = { 1, 2, 4, 8 };
+    for (int roi = 0; roi < 2; roi++)
+    {
+        for (size_t d = 0; d < sizeof(scale_denoms) / sizeof(scale_denoms[0]); d++)
+        {
+            start = std::chrono::steady_clock::now();
+            for (int it = 0; it < NUM_ITERATIONS; it++)
+            {
+                for (int i = 0; i < NUM_IMG; i++)
+                {
+                    ERImageDecodeOptions options;
+                    memset(&options, 0, sizeof(options));
+                    options.scale_denom = scale_denoms[d];
+                    if (roi)
+                    {
+                        // Decode the bottom half of the image only
+                        options.roi_col = 0;
+                        options.roi_row = heights[i] / 2;
+                        options.roi_width = widths[i];
+                        options.roi_height = heights[i] - heights[i] / 2;
+                    }
+
+                    ERImage image;
+                    if (erImageDecode(&image, buffers[i].data(), buffers[i].size(), &options) != 0)
+                    {
+                        printf("erImageDecode failed: %s\n", erGetErrorLog());
+                        return -1;
+                    }
+                    // Output geometry of erImageDecode (see ERImageDecodeOptions)
+                    unsigned int denom = scale_denoms[d];
+                    unsigned int first_row = roi ? options.roi_row / denom : 0;
+                    unsigned int expected_width = (widths[i] + denom - 1) / denom;
+                    unsigned int expected_height = (heights[i] + denom - 1) / denom - first_row;
+                    if (image.width != expected_width || image.height != expected_height)
+                    {
+                        printf("erImageDecode 1/%u%s of image %d: %ux%u instead of %ux%u.\n", denom, roi ? ", ROI" : "",
+                            i, image.width, image.height, expected_width, expected_height);
+                        erImageFree(&image);
+                        return -1;
+                    }
+                    erImageFree(&image);
+                }
+            }
+            printf("  - erImageDecode 1/%u%s: %8.2f ms/image\n", scale_denoms[d], roi ? ", ROI" : "     ",
+                elapsedMs(start) / num_images);
+        }
+    }
+
+    return 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Color conversion: erImageConvert throughput per megapixel for all pairs of
+// color models; the SIMD results are checked to be bit-exact with the scalar
+// ones, and the conversions from BGR and between I420 and NV12 are checked
+// to be bit-exact with references computed here pixel by pixel
+//
+// Largest allowed channel difference of the BGR -> NV12 -> BGR round trip
+#define ROUND_TRIP_TOLERANCE    4
+
+typedef std::pair<const unsigned char *, unsigned int> SampleRow;
+
+// Pointers and byte sizes of all the sample rows of an image: the pixel rows, or the luma rows followed by
+// the chroma rows for YCbCr color models (chroma at data + step * height, see er_image.h)
+static std::vector<SampleRow> sampleRows(const ERImage &image)
+{
+    std::vector<SampleRow> rows;
+    bool ycbcr = image.color_model == ER_IMAGE_COLORMODEL_YCBCR420 || image.color_model == ER_IMAGE_COLORMODEL_YCBCRNV12;
+    for (unsigned int row = 0; row < image.height; row++)
+    {
+        rows.push_back(SampleRow(erImageGetRow(&image, row), ycbcr ? image.width : image.width * image.depth));
+    }
+    const unsigned char *chroma = image.data + (size_t)image.step * image.height;
+    if (image.color_model == ER_IMAGE_COLORMODEL_YCBCRNV12)
+    {
+        for (unsigned int row = 0; row < image.height / 2; row++)
+        {
+            rows.push_back(SampleRow(chroma + (size_t)row * image.step, image.width));
+        }
+    }
+    else if (image.color_model == ER_IMAGE_COLORMODEL_YCBCR420)
+    {
+        // The Cb plane followed by the Cr plane, both with half the row step
+        for (unsigned int row = 0; row < image.height; row++)
+        {
+            rows.push_back(SampleRow(chroma + (size_t)row * (image.step / 2), image.width / 2));
+        }
+    }
+    return rows;
+}
+
+static bool sameImageData(const ERImage &a, const ERImage &b)
+{
+    std::vector<SampleRow> a_rows = sampleRows(a);
+    std::vector<SampleRow> b_rows = sampleRows(b);
+    for (size_t row = 0; row < a_rows.size(); row++)
+    {
+        if (memcmp(a_rows[row].first, b_rows[row].first, a_rows[row].second) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Largest difference of the corresponding samples of two images of the same geometry and color model
+static int maxSampleDifference(const ERImage &a, const ERImage &b)
+{
+    std::vector<SampleRow> a_rows = sampleRows(a);
+    std::vector<SampleRow> b_rows = sampleRows(b);
+    int max_difference = 0;
+    for (size_t row = 0; row < a_rows.size(); row++)
+    {
+        for (unsigned int i = 0; i < a_rows[row].second; i++)
+        {
+            max_difference = std::max(max_difference, abs((int)a_rows[row].first[i] - (int)b_rows[row].first[i]));
+        }
+    }
+    return max_difference;
+}
+
+// Converts src by erImageConvert and compares the result with the reference, returns 0 if within the tolerance
+static int checkReference(const char *name, const ERImage &src, const ERImage &reference, int tolerance)
+{
+    ERImage result;
+    memset(&result, 0, sizeof(result));
+    if (erImageConvert(&src, &result, reference.color_model) != 0)
+    {
+        printf("  - reference %-14s: erImageConvert failed: %s\n", name, erGetErrorLog());
+        return 1;
+    }
+    int max_difference = maxSampleDifference(result, reference);
+    erImageFree(&result);
+    printf("  - reference %-14s: max difference %3d (tolerance %d)%s\n", name, max_difference, tolerance,
+        max_difference <= tolerance ? "" : ", FAILED");
+    return max_difference <= tolerance ? 0 : 1;
+}
+
+// BT.601 formulas of erImageConvert (see er_image.h), computed independently of the library
+static unsigned char referenceGray(int b, int g, int r)
+{
+    return (unsigned char)((299 * r + 587 * g + 114 * b + 500) / 1000);
+}
+
+static unsigned char referenceY(int b, int g, int r)
+{
+    return (unsigned char)((66 * r + 129 * g + 25 * b + 4224) >> 8);
+}
+
+static unsigned char referenceCb(int b, int g, int r)
+{
+    return (unsigned char)((-38 * r - 74 * g + 112 * b + 32896) >> 8);
+}
+
+static unsigned char referenceCr(int b, int g, int r)
+{
+    return (unsigned char)((112 * r - 94 * g - 18 * b + 32896) >> 8);
+}
+
+// Checks BGRA -> BGR, BGR -> BGRA, BGR -> GRAY, BGR -> NV12, BGR -> I420 and I420 <-> NV12 against the references,
+// and the BGR -> NV12 -> BGR round trip within the tolerance; returns the number of failures
+static int checkReferences(const ERImage &bgr)
+{
+    unsigned int width = bgr.width;
+    unsigned int height = bgr.height;
+    ERImage bgra, gray, nv12, i420, bgr_blocks;
+    memset(&bgra, 0, sizeof(bgra));
+    memset(&gray, 0, sizeof(gray));
+    memset(&nv12, 0, sizeof(nv12));
+    memset(&i420, 0, sizeof(i420));
+    memset(&bgr_blocks, 0, sizeof(bgr_blocks));
+    if (erImageAllocate(&bgra, width, height, ER_IMAGE_COLORMODEL_BGRA, ER_IMAGE_DATATYPE_UCHAR) != 0 ||
+        erImageAllocate(&gray, width, height, ER_IMAGE_COLORMODEL_GRAY, ER_IMAGE_DATATYPE_UCHAR) != 0 ||
+        erImageAllocate(&nv12, width, height, ER_IMAGE_COLORMODEL_YCBCRNV12, ER_IMAGE_DATATYPE_UCHAR) != 0 ||
+        erImageAllocate(&i420, width, height, ER_IMAGE_COLORMODEL_YCBCR420, ER_IMAGE_DATATYPE_UCHAR) != 0 ||
+        erImageAllocate(&bgr_blocks, width, height, ER_IMAGE_COLORMODEL_BGR, ER_IMAGE_DATATYPE_UCHAR) != 0)
+    {
+        printf("erImageAllocate failed: %s\n", erGetErrorLog());
+        erImageFree(&bgra);
+        erImageFree(&gray);
+        erImageFree(&nv12);
+        erImageFree(&i420);
+        erImageFree(&bgr_blocks);
+        return 1;
+    }
+
+    for (unsigned int row = 0; row < height; row++)
+    {
+        const unsigned char *bgr_row = erImageGetRow(&bgr, row);
+        const unsigned char *block_row = erImageGetRow(&bgr, row & ~1u);
+        unsigned char *bgra_row = erImageGetRow(&bgra, row);
+        unsigned char *gray_row = erImageGetRow(&gray, row);
+        unsigned char *nv12_y_row = nv12.data + (size_t)row * nv12.step;
+        unsigned char *i420_y_row = i420.data + (size_t)row * i420.step;
+        unsigned char *bgr_blocks_row = erImageGetRow(&bgr_blocks, row);
+        for (unsigned int col = 0; col < width; col++)
+        {
+            const unsigned char *p = bgr_row + 3 * col;
+            bgra_row[4 * col + 0] = p[0];
+            bgra_row[4 * col + 1] = p[1];
+            bgra_row[4 * col + 2] = p[2];
+            bgra_row[4 * col + 3] = 255;
+            gray_row[col] = referenceGray(p[0], p[1], p[2]);
+            nv12_y_row[col] = i420_y_row[col] = referenceY(p[0], p[1], p[2]);
+            // Every 2x2 block has a single color, so the chroma subsampling loses nothing
+            memcpy(bgr_blocks_row + 3 * col, block_row + 3 * (col & ~1u), 3);
+        }
+    }
+
+    // Chroma of each 2x2 block from its average color
+    unsigned char *nv12_uv = nv12.data + (size_t)nv12.step * height;
+    unsigned char *i420_u = i420.data + (size_t)i420.step * height;
+    unsigned char *i420_v = i420_u + (size_t)(i420.step / 2) * (height / 2);
+    for (unsigned int row = 0; row < height / 2; row++)
+    {
+        const unsigned char *top = erImageGetRow(&bgr, 2 * row);
+        const unsigned char *bottom = erImageGetRow(&bgr, 2 * row + 1);
+        for (unsigned int col = 0; col < width / 2; col++)
+        {
+            int average[3];
+            for (int c = 0; c < 3; c++)
+            {
+                average[c] = (top[6 * col + c] + top[6 * col + 3 + c] + bottom[6 * col + c] + bottom[6 * col + 3 + c] + 2) >> 2;
+            }
+            unsigned char cb = referenceCb(average[0], average[1], average[2]);
+            unsigned char cr = referenceCr(average[0], average[1], average[2]);
+            nv12_uv[(size_t)row * nv12.step + 2 * col + 0] = cb;
+            nv12_uv[(size_t)row * nv12.step + 2 * col + 1] = cr;
+            i420_u[(size_t)row * (i420.step / 2) + col] = cb;
+            i420_v[(size_t)row * (i420.step / 2) + col] = cr;
+        }
+    }
+
+    int num_failures = 0;
+    num_failures += checkReference("BGRA -> BGR", bgra, bgr, 0);
+    num_failures += checkReference("BGR -> BGRA", bgr, bgra, 0);
+    num_failures += checkReference("BGR -> GRAY", bgr, gray, 0);
+    num_failures += checkReference("BGR -> NV12", bgr, nv12, 0);
+    num_failures += checkReference("BGR -> I420", bgr, i420, 0);
+    num_failures += checkReference("I420 -> NV12", i420, nv12, 0);
+    num_failures += checkReference("NV12 -> I420", nv12, i420, 0);
+
+    ERImage nv12_blocks;
+    memset(&nv12_blocks, 0, sizeof(nv12_blocks));
+    if (erImageConvert(&bgr_blocks, &nv12_blocks, ER_IMAGE_COLORMODEL_YCBCRNV12) != 0)
+    {
+        printf("  - reference %-14s: erImageConvert failed: %s\n", "BGR -> NV12", erGetErrorLog());
+        num_failures++;
+    }
+    else
+    {
+        num_failures += checkReference("NV12 -> BGR", nv12_blocks, bgr_blocks, ROUND_TRIP_TOLERANCE);
+        erImageFree(&nv12_blocks);
+    }
+
+    erImageFree(&bgra);
+    erImageFree(&gray);
+    erImageFree(&nv12);
+    erImageFree(&i420);
+    erImageFree(&bgr_blocks);
+
+    return num_failures;
+}
+
+static void freeImages(std::vector<ERImage> &images)
+{
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        erImageFree(&images[i]);
+    }
+    images.clear();
+}
+
+static int benchmarkConvert()
+{
+    const ERImageColorModel color_models[] = { ER_IMAGE_COLORMODEL_GRAY, ER_IMAGE_COLORMODEL_BGR, ER_IMAGE_COLORMODEL_BGRA,
+        ER_IMAGE_COLORMODEL_YCBCR420, ER_IMAGE_COLORMODEL_YCBCRNV12 };
+    const char *color_model_names[] = { "GRAY", "BGR", "BGRA", "I420", "NV12" };
+    const int num_color_models = sizeof(color_models) / sizeof(color_models[0]);
+
+    ERImage bgr;
+    if (erImageRead(&bgr, TestImageList[0]) != 0)
+    {
+        std::cerr << "Can't load the file: " << TestImageList[0] << std::endl;
+        return -1;
+    }
+    // YCbCr 4:2:0 images need even dimensions
+    ERImage bgr_even;
+    erImageInitView(&bgr_even, bgr.width & ~1u, bgr.height & ~1u, bgr.color_model, bgr.data_type, bgr.data, (int)bgr.step);
+
+    // The source images in all color models
+    std::vector<ERImage> sources;
+    for (int m = 0; m < num_color_models; m++)
+    {
+        ERImage source;
+        memset(&source, 0, sizeof(source));
+        if (erImageConvert(&bgr_even, &source, color_models[m]) != 0)
+        {
+            printf("erImageConvert to %s failed: %s\n", color_model_names[m], erGetErrorLog());
+            freeImages(sources);
+            erImageFree(&bgr);
+            return -1;
+        }
+        sources.push_back(source);
+    }
+
+    ERImageSimdLevel simd_level = erImageGetSimdLevel();
+    double megapixels = bgr_even.width * (double)bgr_even.height / 1e6;
+    int num_failures = 0;
+
+    printf("Color conversion (%ux%u, SIMD level %d, %d iterations):\n", bgr_even.width, bgr_even.height, (int)simd_level, NUM_ITERATIONS);
+    for (int src = 0; src < num_color_models; src++)
+    {
+        for (int dst = 0; dst < num_color_models; dst++)
+        {
+            if (src == dst)
+            {
+                continue;
+            }
+
+            double ms[2];
+            ERImage results[2];
+            bool converted = true;
+            memset(results, 0, sizeof(results));
+            for (int simd = 0; simd < 2 && converted; simd++)
+            {
+                erImageSetMaxSimdLevel(simd ? simd_level : ER_IMAGE_SIMD_NONE);
+                // The first call allocates the destination, the timed ones reuse it
+                converted = erImageConvert(&sources[src], &results[simd], color_models[dst]) == 0;
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                for (int it = 0; it < NUM_ITERATIONS && converted; it++)
+                {
+                    converted = erImageConvert(&sources[src], &results[simd], color_models[dst]) == 0;
+                }
+                ms[simd] = elapsedMs(start) / NUM_ITERATIONS;
+            }
+
+            if (!converted)
+            {
+                num_failures++;
+                printf("  - %4s -> %-4s: FAILED: %s\n", color_model_names[src], color_model_names[dst], erGetErrorLog());
+            }
+            else
+            {
+                bool bit_exact = sameImageData(results[0], results[1]);
+                num_failures += bit_exact ? 0 : 1;
+                printf("  - %4s -> %-4s: scalar %8.2f MPix/s, SIMD %8.2f MPix/s%s\n",
+                    color_model_names[src], color_model_names[dst],
+                    1000.0 * megapixels / ms[0], 1000.0 * megapixels / ms[1], bit_exact ? "" : ", NOT BIT-EXACT");
+            }
+
+            erImageFree(&results[0]);
+            erImageFree(&results[1]);
+        }
+    }
+
+    // The references are checked with the scalar and with the SIMD kernels
+    for (int simd = 0; simd < 2; simd++)
+    {
+        erImageSetMaxSimdLevel(simd ? simd_level : ER_IMAGE_SIMD_NONE);
+        printf("Reference checks (%s):\n", simd ? "SIMD" : "scalar");
+        num_failures += checkReferences(bgr_even);
+    }
+    erImageSetMaxSimdLevel(simd_level);
+
+    freeImages(sources);
+    erImageFree(&bgr);
+
+    return num_failures == 0 ? 0 : -1;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Cold start: lpmInit + lpmLoadModule ("startup save", which also writes the
+// snapshot) compared with lazy lpmInitEx + lpmLoadModuleSnapshot ("startup
+// load"). Each mode measures a fresh process, so run them as two separate
+// invocations and drop the page cache in between (as root:
+// sync; echo 3 > /proc/sys/vm/drop_caches), otherwise the module files of
+// the regular start are read from memory. The load mode evicts the snapshot
+// file from the page cache itself where posix_fadvise is available.
+//
+#define SNAPSHOT_FILENAME       "module.snapshot"
+
+static int benchmarkStartupSave(int module_id)
+{
+    LPMState lpm_state;
+    int module_idx;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (lpmInit(MODULES_DIR, &lpm_state) != 0)
+    {
+        printf("LPM could not be initialized, code %d.\n", lpmGetLastError());
+        return -1;
+    }
+    double init_ms = elapsedMs(start);
+    start = std::chrono::steady_clock::now();
+    if ((module_idx = lpmGetModuleIndex(lpm_state, module_id, 0, 0)) == -1 || lpmLoadModule(lpm_state, module_idx, NULL, NULL) != 0)
+    {
+        printf("LPM module with ID %d could not be loaded.\n", module_id);
+        lpmFree(&lpm_state);
+        return -1;
+    }
+    double load_ms = elapsedMs(start);
+
+    // The snapshot is written after the measurement, for the load mode
+    int ret_code = lpmSaveModuleSnapshot(lpm_state, module_idx, SNAPSHOT_FILENAME);
+    lpmFreeModule(lpm_state, module_idx);
+    lpmFree(&lpm_state);
+    if (ret_code != 0)
+    {
+        printf("lpmSaveModuleSnapshot failed, code %d.\n", ret_code);
+        return -1;
+    }
+
+    printf("Cold start (fresh process):\n");
+    printf("  - lpmInit + lpmLoadModule                 : %8.2f + %8.2f ms\n", init_ms, load_ms);
+    printf("Snapshot written to '%s', drop the page cache and run 'startup load'.\n", SNAPSHOT_FILENAME);
+
+    return 0;
+}
+
+static int benchmarkStartupLoad()
+{
+    LPMState lpm_state;
+    int module_idx;
+    int ret_code;
+
+#ifdef __linux__
+    // Evict the snapshot from the page cache, so it is read from the disk
+    int fd = open(SNAPSHOT_FILENAME, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Snapshot '%s' not found, run 'startup save' first.\n", SNAPSHOT_FILENAME);
+        return -1;
+    }
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+#endif
+
+    LpmInitConfig init_config;
+    memset(&init_config, 0, sizeof(init_config));
+    init_config.lazy_discovery = 1;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (lpmInitEx(MODULES_DIR, &lpm_state, &init_config) != 0)
+    {
+        printf("LPM could not be initialized, code %d.\n", lpmGetLastError());
+        return -1;
+    }
+    double lazy_init_ms = elapsedMs(start);
+    start = std::chrono::steady_clock::now();
+    if ((ret_code = lpmLoadModuleSnapshot(lpm_state, SNAPSHOT_FILENAME, &module_idx)) != 0)
+    {
+        printf("lpmLoadModuleSnapshot failed, code %d.\n", ret_code);
+        lpmFree(&lpm_state);
+        return -1;
+    }
+    double snapshot_load_ms = elapsedMs(start);
+    lpmFreeModule(lpm_state, module_idx);
+    lpmFree(&lpm_state);
+
+    printf("Cold start (fresh process):\n");
+    printf("  - lazy lpmInitEx + lpmLoadModuleSnapshot  : %8.2f + %8.2f ms\n", lazy_init_ms, snapshot_load_ms);
+
+    return 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+// LPM benchmark                                                            //
+//////////////////////////////////////////////////////////////////////////////
+//   Usage: benchmark BENCHMARK [MODULE_ID]                                 //
+//   Available benchmarks:                                                  //
+//       det-batch  - detection throughput of lpmRunDetBatch                //
+//       det-ocr    - latency of lpmRunDetOcr vs. lpmRunDet + lpmRunOcr     //
+//       workers    - concurrent worker det/OCR calls on shared weights     //
+//       executor   - lpmRunDet tail latency with a shared LpmExecutor      //
+//       warmup     - first call after warm-up vs. steady-state median      //
+//       decode     - erImageDecode vs. erImageRead (no module needed)      //
+//       convert    - erImageConvert throughput (no module needed)          //
+//       startup save - cold start with lpmLoadModule, writes a snapshot    //
+//       startup load - cold start with lazy init and the module snapshot   //
+//   Run each startup mode in a fresh process with the page cache dropped.  //
+//   All measurements run on CPU with the default number of threads.        //
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+    LPMState lpm_state;
+    int module_idx;
+    int ret_code;
+
+    if (argc < 2)
+    {
+        printf("Usage: %s det-batch|det-ocr|workers|executor|warmup|decode|convert|startup [save|load] [MODULE_ID]\n", argv[0]);
+        return -1;
+    }
+    const char *benchmark = argv[1];
+
+    // Benchmarks of the ERImage functions do not need any LPM module
+    if (strcmp(benchmark, "decode") == 0)
+    {
+        return benchmarkDecode();
+    }
+    if (strcmp(benchmark, "convert") == 0)
+    {
+        return benchmarkConvert();
+    }
+
+    // The cold start benchmarks initialize the LPM on their own
+    if (strcmp(benchmark, "startup") == 0 && argc >= 3 && strcmp(argv[2], "load") == 0)
+    {
+        return benchmarkStartupLoad();
+    }
+    if (strcmp(benchmark, "startup") == 0)
+    {
+        if (argc < 4 || strcmp(argv[2], "save") != 0)
+        {
+            printf("Usage: %s startup save MODULE_ID | startup load\n", argv[0]);
+            return -1;
+        }
+        return benchmarkStartupSave(atoi(argv[3]));
+    }
+
+    if (argc < 3)
+    {
+        printf("Benchmark '%s' needs MODULE_ID.\n", benchmark);
+        return -1;
+    }
+    int module_id = atoi(argv[2]);
+
+    if ((ret_code = lpmInit(MODULES_DIR, &lpm_state)) != 0)
+    {
+        printf("LPM could not be initialized, code %d.\n", ret_code);
+        return -1;
+    }
+
+    printf("LPM v%u.%u initialized\n\n", (unsigned char)(lpmVersion() >> CHAR_BIT), (unsigned char)(lpmVersion()));
+
+    if ((module_idx = lpmGetModuleIndex(lpm_state, module_id, 0, 0)) == -1)
+    {
+        printf("LPM module with ID %d is not available.\n", module_id);
+        lpmFree(&lpm_state);
+        return -1;
+    }
+
+    // Force CPU computation for all the measurements
+    LpmModuleConfig lpm_module_config;
+    memset(&lpm_module_config, 0, sizeof(lpm_module_config));
+    LpmModuleConfig_extension1 lpm_module_config_extension1;
+    memset(&lpm_module_config_extension1, 0, sizeof(lpm_module_config_extension1));
+    LpmModuleConfig_extension2 lpm_module_config_extension2;
+    memset(&lpm_module_config_extension2, 0, sizeof(lpm_module_config_extension2));
+    lpm_module_config_extension2.det_max_batch_size = 16;
+    lpm_module_config_extension1.extras = &lpm_module_config_extension2;
+    lpm_module_config.extras = &lpm_module_config_extension1;
+
+    if ((ret_code = lpmLoadModule(lpm_state, module_idx, NULL, &lpm_module_config)) != 0)
+    {
+        printf("LPM module could not be loaded, code %d.\n", ret_code);
+        lpmFree(&lpm_state);
+        return -1;
+    }
+
+    // Application pool of the executor benchmark, destroyed after lpmFreeModule
+    std::unique_ptr<ThreadPool> executor_pool;
+
+    // Read all the test images
+    std::vector<ERImage> images;
+    for (int i = 0; i < NUM_IMG; i++)
+    {
+        ERImage er_image;
+        if (erImageRead(&er_image, TestImageList[i]) != 0)
+        {
+            std::cerr << "Can't load the file: " << TestImageList[i] << std::endl;
+            continue;
+        }
+        images.push_back(er_image);
+    }
+
+    if (images.empty())
+    {
+        ret_code = -1;
+    }
+    else if (strcmp(benchmark, "det-batch") == 0)
+    {
+        ret_code = benchmarkDetBatch(lpm_state, module_idx, images);
+    }
+    else if (strcmp(benchmark, "det-ocr") == 0)
+    {
+        ret_code = benchmarkDetOcr(lpm_state, module_idx, images);
+    }
+    else if (strcmp(benchmark, "workers") == 0)
+    {
+        ret_code = benchmarkWorkers(lpm_state, module_idx, images);
+    }
+    else if (strcmp(benchmark, "warmup") == 0)
+    {
+        ret_code = benchmarkWarmup(lpm_state, module_idx, images);
+    }
+    else if (strcmp(benchmark, "executor") == 0)
+    {
+        int num_threads = (int)std::thread::hardware_concurrency();
+        executor_pool.reset(new ThreadPool(num_threads < 1 ? 1 : num_threads));
+        ret_code = benchmarkExecutor(lpm_state, module_idx, images, lpm_module_config, *executor_pool);
+    }
+    else
+    {
+        printf("Unknown benchmark '%s'.\n", benchmark);
+        ret_code = -1;
+    }
+
+    // Cleaning up
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        erImageFree(&images[i]);
+    }
+    lpmFreeModule(lpm_state, module_idx);
+    lpmFree(&lpm_state);
+
+    return ret_code;
+}
@@ -42,6 +42,12 @@ ER_IMAGE_ALL_DATATYPES = [ER_IMAGE_DATATYPE_UNK,
                           ER_IMAGE_DATATYPE_UCHAR,
                           ER_IMAGE_DATATYPE_FLOAT]
 
+ER_IMAGE_DATA_EXTERNAL = 0
+ER_IMAGE_DATA_ALLOCATED = 1
+ER_IMAGE_DATA_VIEW = 2
+ER_IMAGE_DATA_VIEW_NEGATIVE = 3
+ER_IMAGE_DATA_POOLED = 4
+
 ER_COMPUTATION_MODE_CPU = 0
 ER_COMPUTATION_MODE_GPU = 1
 ER_COMPUTATION_MODE_TPU = 2
@@ -315,6 +321,13 @@ class ER:
 
         return er_image_gc
 
+    @staticmethod
+    def get_erimage_row(er_image, row):
+        # same as erImageGetRow() of er_image.h, works for views with negative row step as well
+        if er_image.data_allocated == ER_IMAGE_DATA_VIEW_NEGATIVE:
+            return er_image.data - row * er_image.step
+        return er_image.data + row * er_image.step
+
     @staticmethod
     def convert_erimage_to_nparray(er_image):
         # alloc new numpy array
@@ -332,12 +345,11 @@ class ER:
         else:
             raise TypeError("Expected er_image.color_model either GRAY or BGR.")
 
-        # check there is no step
-        if er_image.depth * er_image.width != er_image.step:
-            raise ValueError("Input image data not continuous - not implemented.")
-
-        b = bytearray(er_image.data_size)
-        FFI().memmove(b, er_image.data, er_image.data_size)
+        # copy row by row, the image can be padded or a view with negative row step
+        row_size = er_image.depth * er_image.width
+        b = bytearray(row_size * er_image.height)
+        for row in range(er_image.height):
+            FFI().memmove(memoryview(b)[row * row_size:(row + 1) * row_size], ER.get_erimage_row(er_image, row), row_size)
         np_image = np.frombuffer(b, np_dtype, er_image.height * er_image.width * er_image.num_channels)
         np_image = np.reshape(np_image, [er_image.height, er_image.width, er_image.num_channels])
 